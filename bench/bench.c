@@ -0,0 +1,226 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Elias Engelbert Plank
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+#include "bench.h"
+
+#ifndef SOLARIS_BENCH_BUILD_TYPE
+#define SOLARIS_BENCH_BUILD_TYPE ""
+#endif
+
+enum {
+    BENCH_MAX_SAMPLES = 1024,
+    BENCH_MAX_ITERATIONS = 1 << 30,
+};
+
+/// Sink for the computed values of the benchmarks
+static volatile f64 bench_sink;
+
+/// Creates the default benchmark options
+BenchOptions bench_options_default(void) {
+    BenchOptions options;
+    options.warmup = 3;
+    options.samples = 31;
+    options.min_sample_time = 0.005;
+    options.filter = nil;
+    options.output = "bench_output.json";
+    return options;
+}
+
+/// Parses the command line into the benchmark options
+b8 bench_options_parse(BenchOptions *const options, int const argc, char **const argv) {
+    for (int i = 1; i < argc; ++i) {
+        char const *const flag = argv[i];
+        if (i + 1 >= argc) {
+            fprintf(stderr, "usage: %s [--filter name] [--output file|-] [--samples n] [--warmup n] [--min-time s]\n",
+                    argv[0]);
+            return false;
+        }
+        char const *const value = argv[++i];
+        if (strcmp(flag, "--filter") == 0) {
+            options->filter = value;
+        } else if (strcmp(flag, "--output") == 0) {
+            options->output = value;
+        } else if (strcmp(flag, "--samples") == 0) {
+            options->samples = (usize) strtoull(value, nil, 10);
+        } else if (strcmp(flag, "--warmup") == 0) {
+            options->warmup = (usize) strtoull(value, nil, 10);
+        } else if (strcmp(flag, "--min-time") == 0) {
+            options->min_sample_time = strtod(value, nil);
+        } else {
+            fprintf(stderr, "unknown option %s\n", flag);
+            return false;
+        }
+    }
+    if (options->samples == 0) {
+        options->samples = 1;
+    }
+    if (options->samples > BENCH_MAX_SAMPLES) {
+        options->samples = BENCH_MAX_SAMPLES;
+    }
+    return true;
+}
+
+/// Retrieves a monotonic timestamp
+f64 bench_now(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return (f64) counter.QuadPart * 1e9 / (f64) frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (f64) now.tv_sec * 1e9 + (f64) now.tv_nsec;
+#endif
+}
+
+/// Keeps the compiler from discarding a computed value
+void bench_consume(f64 const value) {
+    bench_sink = value;
+}
+
+/// Runs a single sample and returns its duration in nanoseconds
+static f64 bench_sample(BenchCase const *const bench_case, usize const iterations) {
+    f64 const start = bench_now();
+    bench_case->run(bench_case->state, iterations);
+    return bench_now() - start;
+}
+
+/// Compares two samples for sorting
+static int bench_sample_compare(void const *const a, void const *const b) {
+    f64 const left = *(f64 const *) a;
+    f64 const right = *(f64 const *) b;
+    return (left > right) - (left < right);
+}
+
+/// Retrieves the percentile of the sorted samples (nearest rank)
+static f64 bench_percentile(f64 const *const sorted, usize const count, f64 const percentile) {
+    usize rank = (usize) (percentile / 100.0 * (f64) count + 0.5);
+    if (rank < 1) {
+        rank = 1;
+    }
+    if (rank > count) {
+        rank = count;
+    }
+    return sorted[rank - 1];
+}
+
+/// Runs the benchmark case with warmup and repeated samples
+BenchResult bench_run(BenchOptions const *const options, BenchCase const *const bench_case) {
+    f64 const min_sample_time = options->min_sample_time * 1e9;
+
+    // Calibrate the iteration count, which also warms up caches and branch predictors
+    usize iterations = 1;
+    while (iterations < BENCH_MAX_ITERATIONS && bench_sample(bench_case, iterations) < min_sample_time) {
+        iterations *= 2;
+    }
+    for (usize i = 0; i < options->warmup; ++i) {
+        bench_sample(bench_case, iterations);
+    }
+
+    f64 samples[BENCH_MAX_SAMPLES];
+    f64 sum = 0.0;
+    for (usize i = 0; i < options->samples; ++i) {
+        samples[i] = bench_sample(bench_case, iterations) / (f64) iterations;
+        sum += samples[i];
+    }
+    qsort(samples, options->samples, sizeof(f64), bench_sample_compare);
+
+    BenchResult result;
+    result.name = bench_case->name;
+    result.iterations = iterations;
+    result.samples = options->samples;
+    result.min = samples[0];
+    result.p50 = bench_percentile(samples, options->samples, 50.0);
+    result.p90 = bench_percentile(samples, options->samples, 90.0);
+    result.p99 = bench_percentile(samples, options->samples, 99.0);
+    result.max = samples[options->samples - 1];
+    result.mean = sum / (f64) options->samples;
+    return result;
+}
+
+/// Writes the results as JSON
+static void bench_write_json(FILE *const file, BenchResult const *const results, usize const count) {
+    fprintf(file, "{\n  \"build\": \"%s\",\n  \"unit\": \"ns/op\",\n  \"benchmarks\": [\n",
+            SOLARIS_BENCH_BUILD_TYPE);
+    for (usize i = 0; i < count; ++i) {
+        BenchResult const *const result = results + i;
+        fprintf(file,
+                "    {\"name\": \"%s\", \"iterations\": %zu, \"samples\": %zu, \"min\": %.3f, \"p50\": %.3f, "
+                "\"p90\": %.3f, \"p99\": %.3f, \"max\": %.3f, \"mean\": %.3f}%s\n",
+                result->name, result->iterations, result->samples, result->min, result->p50, result->p90,
+                result->p99, result->max, result->mean, i + 1 < count ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+}
+
+/// Runs every benchmark case that matches the filter
+b8 bench_run_all(BenchOptions const *const options, BenchCase const *const cases, usize const count) {
+    BenchResult *results = malloc(count * sizeof(BenchResult));
+    usize result_count = 0;
+
+    FILE *const summary = options->output != nil && strcmp(options->output, "-") == 0 ? stderr : stdout;
+    fprintf(summary, "%-40s %12s %12s %12s %12s\n", "benchmark", "min", "p50", "p90", "p99");
+    for (usize i = 0; i < count; ++i) {
+        if (options->filter != nil && strstr(cases[i].name, options->filter) == nil) {
+            continue;
+        }
+        BenchResult const result = bench_run(options, cases + i);
+        fprintf(summary, "%-40s %12.1f %12.1f %12.1f %12.1f\n", result.name, result.min, result.p50, result.p90,
+                result.p99);
+        results[result_count++] = result;
+    }
+
+    b8 written = true;
+    if (options->output != nil) {
+        FILE *const file = strcmp(options->output, "-") == 0 ? stdout : fopen(options->output, "w");
+        if (file != nil) {
+            bench_write_json(file, results, result_count);
+            if (file != stdout) {
+                fclose(file);
+            }
+        } else {
+            fprintf(stderr, "cannot write %s\n", options->output);
+            written = false;
+        }
+    }
+    free(results);
+    return written;
+}
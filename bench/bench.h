@@ -0,0 +1,94 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Elias Engelbert Plank
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SOLARIS_BENCH_H
+#define SOLARIS_BENCH_H
+
+#include <solaris/types.h>
+
+/// Runs the benchmarked operation the specified amount of times
+typedef void (*BenchFunc)(void *state, usize iterations);
+
+typedef struct BenchCase {
+    char const *name;
+    BenchFunc run;
+    void *state;
+} BenchCase;
+
+typedef struct BenchOptions {
+    usize warmup;
+    usize samples;
+    f64 min_sample_time;
+    char const *filter;
+    char const *output;
+} BenchOptions;
+
+typedef struct BenchResult {
+    char const *name;
+    usize iterations;
+    usize samples;
+    f64 min;
+    f64 p50;
+    f64 p90;
+    f64 p99;
+    f64 max;
+    f64 mean;
+} BenchResult;
+
+/// Creates the default benchmark options
+/// @return Benchmark options
+BenchOptions bench_options_default(void);
+
+/// Parses the command line into the benchmark options
+/// @param options The options that are modified
+/// @param argc The argument count
+/// @param argv The argument vector
+/// @return Boolean that states whether the command line is valid
+b8 bench_options_parse(BenchOptions *options, int argc, char **argv);
+
+/// Retrieves a monotonic timestamp
+/// @return Timestamp in nanoseconds
+f64 bench_now(void);
+
+/// Keeps the compiler from discarding a computed value
+/// @param value The value
+void bench_consume(f64 value);
+
+/// Runs the benchmark case with warmup and repeated samples
+/// @param options The benchmark options
+/// @param bench_case The benchmark case
+/// @return The result in nanoseconds per operation
+///
+/// @note The iteration count of a sample is doubled until one sample
+///       takes at least the minimum sample time
+BenchResult bench_run(BenchOptions const *options, BenchCase const *bench_case);
+
+/// Runs every benchmark case that matches the filter, prints a summary and
+/// writes the machine-readable results
+/// @param options The benchmark options
+/// @param cases The benchmark cases
+/// @param count The amount of benchmark cases
+/// @return Boolean that states whether the results could be written
+b8 bench_run_all(BenchOptions const *options, BenchCase const *cases, usize count);
+
+#endif// SOLARIS_BENCH_H
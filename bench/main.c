@@ -0,0 +1,543 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Elias Engelbert Plank
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <stdlib.h>
+
+#include <solaris/solaris.h>
+
+#include "bench.h"
+
+/// Shared inputs of the benchmark cases
+typedef struct BenchState {
+    Catalog catalog;
+    MemoryArena arena;
+    SpatialIndex index;
+    Planet const *mars;
+    ThreadPool pool;
+    Ephemeris ephemeris;
+    ObserverContext context;
+    Geographic observer;
+    Time date;
+} BenchState;
+
+static void bench_planet_position_equatorial(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    Planet const *const mars = bench->mars;
+    f64 sum = 0.0;
+    for (usize i = 0; i < iterations; ++i) {
+        Equatorial const position = planet_position_equatorial(mars, &bench->date);
+        sum += position.right_ascension;
+    }
+    bench_consume(sum);
+}
+
+static void bench_planet_positions_single(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    f64 sum = 0.0;
+    for (usize i = 0; i < iterations; ++i) {
+        for (usize planet = 0; planet < bench->catalog.planet_count; ++planet) {
+            Equatorial const position = planet_position_equatorial(bench->catalog.planets + planet, &bench->date);
+            sum += position.right_ascension;
+        }
+    }
+    bench_consume(sum);
+}
+
+static void bench_planet_positions_all(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    f64 sum = 0.0;
+    for (usize i = 0; i < iterations; ++i) {
+        Equatorial positions[PLANET_COUNT];
+        planet_positions_all(&bench->date, positions);
+        sum += positions[PLANET_MARS].right_ascension;
+    }
+    bench_consume(sum);
+}
+
+/// Fills the angles of the trigonometric benchmarks
+static void bench_angles(f64 *const angles, usize const count) {
+    for (usize i = 0; i < count; ++i) {
+        angles[i] = 0.37 * (f64) i - 180.0;
+    }
+}
+
+static void bench_math_sine_cosine(void *const state, usize const iterations) {
+    (void) state;
+    f64 angles[1024];
+    bench_angles(angles, ARRAY_SIZE(angles));
+    f64 sum = 0.0;
+    for (usize i = 0; i < iterations; ++i) {
+        f64 const angle = angles[i % ARRAY_SIZE(angles)];
+        sum += math_sine(angle) + math_cosine(angle);
+    }
+    bench_consume(sum);
+}
+
+static void bench_math_sincos(void *const state, usize const iterations) {
+    (void) state;
+    f64 angles[1024];
+    bench_angles(angles, ARRAY_SIZE(angles));
+    f64 sum = 0.0;
+    for (usize i = 0; i < iterations; ++i) {
+        f64 sine;
+        f64 cosine;
+        math_sincos(angles[i % ARRAY_SIZE(angles)], &sine, &cosine);
+        sum += sine + cosine;
+    }
+    bench_consume(sum);
+}
+
+/// Runs the batch sine and cosine in the accuracy tier
+static void bench_math_sincos_batch_tier(usize const iterations, MathPrecision const precision) {
+    f64 angles[1024];
+    f64 sines[1024];
+    f64 cosines[1024];
+    bench_angles(angles, ARRAY_SIZE(angles));
+
+    MathPrecision const previous = math_precision_get();
+    math_precision_set(precision);
+    f64 sum = 0.0;
+    for (usize i = 0; i < iterations; ++i) {
+        math_sincos_batch(angles, sines, cosines, ARRAY_SIZE(angles));
+        sum += sines[i % ARRAY_SIZE(sines)];
+    }
+    math_precision_set(previous);
+    bench_consume(sum);
+}
+
+static void bench_math_sincos_batch(void *const state, usize const iterations) {
+    (void) state;
+    bench_math_sincos_batch_tier(iterations, MATH_PRECISION_FULL);
+}
+
+static void bench_math_sincos_batch_display(void *const state, usize const iterations) {
+    (void) state;
+    bench_math_sincos_batch_tier(iterations, MATH_PRECISION_DISPLAY);
+}
+
+static void bench_observe_planets(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    f64 sum = 0.0;
+    for (usize i = 0; i < iterations; ++i) {
+        for (usize planet = 0; planet < bench->catalog.planet_count; ++planet) {
+            Equatorial const position = planet_position_equatorial(bench->catalog.planets + planet, &bench->date);
+            Horizontal const horizontal = observe_geographic_ctx(&position, &bench->context, &bench->date);
+            sum += horizontal.altitude;
+        }
+    }
+    bench_consume(sum);
+}
+
+static void bench_observe_planets_context(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    f64 sum = 0.0;
+    for (usize i = 0; i < iterations; ++i) {
+        TimeContext const time = time_context_observer(&bench->date, &bench->context);
+        for (usize planet = 0; planet < bench->catalog.planet_count; ++planet) {
+            Equatorial const position = planet_position_equatorial_context(bench->catalog.planets + planet, &time);
+            Horizontal const horizontal = observe_geographic_context(&position, &bench->context, &time);
+            sum += horizontal.altitude;
+        }
+    }
+    bench_consume(sum);
+}
+
+static void bench_kepler_solve_batch(void *const state, usize const iterations) {
+    (void) state;
+    f64 mean_anomaly[1024];
+    f64 eccentricity[1024];
+    f64 eccentric_anomaly[1024];
+    for (usize i = 0; i < ARRAY_SIZE(mean_anomaly); ++i) {
+        mean_anomaly[i] = 0.01 * (f64) i;
+        eccentricity[i] = 0.9 * (f64) i / (f64) ARRAY_SIZE(mean_anomaly);
+    }
+
+    f64 sum = 0.0;
+    for (usize i = 0; i < iterations; ++i) {
+        kepler_solve_batch(mean_anomaly, eccentricity, eccentric_anomaly, ARRAY_SIZE(mean_anomaly));
+        sum += eccentric_anomaly[i % ARRAY_SIZE(eccentric_anomaly)];
+    }
+    bench_consume(sum);
+}
+
+static void bench_object_position(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    f64 sum = 0.0;
+    for (usize i = 0; i < iterations; ++i) {
+        Object const *const object = bench->catalog.objects + i % bench->catalog.object_count;
+        Equatorial const position = object_position(object, &bench->date);
+        sum += position.right_ascension;
+    }
+    bench_consume(sum);
+}
+
+static void bench_object_position_cache(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    TransformCache cache = transform_cache_make(TRANSFORM_CACHE_QUANTUM);
+    f64 const jdn = time_jdn(&bench->date);
+    f64 sum = 0.0;
+    for (usize i = 0; i < iterations; ++i) {
+        Object const *const object = bench->catalog.objects + i % bench->catalog.object_count;
+        Equatorial const position = object_position_cache(object, &cache, jdn);
+        sum += position.right_ascension;
+    }
+    bench_consume(sum);
+}
+
+static void bench_observe_geographic(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    f64 sum = 0.0;
+    for (usize i = 0; i < iterations; ++i) {
+        Object const *const object = bench->catalog.objects + i % bench->catalog.object_count;
+        Horizontal const horizontal = observe_geographic(&object->position, &bench->observer, &bench->date);
+        sum += horizontal.altitude;
+    }
+    bench_consume(sum);
+}
+
+static void bench_observe_geographic_ctx(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    f64 sum = 0.0;
+    for (usize i = 0; i < iterations; ++i) {
+        Object const *const object = bench->catalog.objects + i % bench->catalog.object_count;
+        Horizontal const horizontal = observe_geographic_ctx(&object->position, &bench->context, &bench->date);
+        sum += horizontal.altitude;
+    }
+    bench_consume(sum);
+}
+
+static void bench_time_add_minutes(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    Time date = bench->date;
+    for (usize i = 0; i < iterations; ++i) {
+        time_add(&date, 1, UNIT_MINUTES);
+    }
+    bench_consume((f64) date.minute);
+}
+
+static void bench_time_add_seconds_day(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    Time date = bench->date;
+    for (usize i = 0; i < iterations; ++i) {
+        time_add(&date, 86400, UNIT_SECONDS);
+        if (date.year > 2100) {
+            date = bench->date;
+        }
+    }
+    bench_consume((f64) date.day);
+}
+
+static void bench_time_add_days(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    Time date = bench->date;
+    for (usize i = 0; i < iterations; ++i) {
+        time_add(&date, 1, UNIT_DAYS);
+        if (date.year > 2100) {
+            date = bench->date;
+        }
+    }
+    bench_consume((f64) date.day);
+}
+
+static void bench_time_gmst(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    Time date = bench->date;
+    f64 sum = 0.0;
+    for (usize i = 0; i < iterations; ++i) {
+        date.second = (s64) (i % 60);
+        sum += time_gmst(&date);
+    }
+    bench_consume(sum);
+}
+
+static void bench_time_gmst_timeline(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    f64 gmst[1440];
+    f64 const start = time_mjdn(&bench->date);
+    f64 sum = 0.0;
+    for (usize i = 0; i < iterations; ++i) {
+        time_gmst_timeline(start, 1.0 / 1440.0, ARRAY_SIZE(gmst), gmst);
+        sum += gmst[i % ARRAY_SIZE(gmst)];
+    }
+    bench_consume(sum);
+}
+
+static void bench_time_iso8601_batch(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    static f64 jdn[1440];
+    static char strings[ARRAY_SIZE(jdn) * TIME_ISO8601_SIZE];
+    f64 const start = time_jdn(&bench->date);
+    for (usize i = 0; i < ARRAY_SIZE(jdn); ++i) {
+        jdn[i] = start + (f64) i / 1440.0;
+    }
+
+    f64 sum = 0.0;
+    for (usize i = 0; i < iterations; ++i) {
+        time_iso8601_batch(jdn, strings, ARRAY_SIZE(jdn));
+        sum += (f64) strings[(i % ARRAY_SIZE(jdn)) * TIME_ISO8601_SIZE + 15];
+    }
+    bench_consume(sum);
+}
+
+static void bench_memory_arena_alloc(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    usize sum = 0;
+    for (usize i = 0; i < iterations; ++i) {
+        if (i % 4096 == 4095) {
+            memory_arena_clear(&bench->arena);
+        }
+        sum += (usize) memory_arena_alloc(&bench->arena, 64);
+    }
+    memory_arena_clear(&bench->arena);
+    bench_consume((f64) sum);
+}
+
+static void bench_memory_arena_rewind(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    MemoryArenaMark const mark = memory_arena_mark(&bench->arena);
+    usize sum = 0;
+    for (usize i = 0; i < iterations; ++i) {
+        if (i % 4096 == 4095) {
+            memory_arena_rewind(&bench->arena, mark);
+        }
+        sum += (usize) memory_arena_alloc(&bench->arena, 64);
+    }
+    memory_arena_rewind(&bench->arena, mark);
+    bench_consume((f64) sum);
+}
+
+static void bench_compute_geographic_fixed(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    ComputeSpecification spec;
+    spec.date = bench->date;
+    spec.observer = bench->observer;
+    spec.steps = 1440;
+    spec.step_size = 1;
+    spec.unit = UNIT_MINUTES;
+
+    f64 sum = 0.0;
+    for (usize i = 0; i < iterations; ++i) {
+        ComputeResult result;
+        compute_geographic_fixed(&bench->arena, &result, bench->catalog.objects, &spec);
+        sum += result.altitudes[result.count - 1];
+        memory_arena_clear(&bench->arena);
+    }
+    bench_consume(sum);
+}
+
+static void bench_compute_sky_snapshot(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    f64 sum = 0.0;
+    for (usize i = 0; i < iterations; ++i) {
+        ComputeResult result;
+        compute_sky_snapshot(&bench->arena, &result, &bench->catalog, &bench->observer, &bench->date);
+        sum += result.altitudes[result.count - 1];
+        memory_arena_clear(&bench->arena);
+    }
+    bench_consume(sum);
+}
+
+static void bench_compute_geographic_planet_year(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    ComputeSpecification spec;
+    spec.date = bench->date;
+    spec.observer = bench->observer;
+    spec.steps = 8760;
+    spec.step_size = 1;
+    spec.unit = UNIT_HOURS;
+
+    f64 sum = 0.0;
+    for (usize i = 0; i < iterations; ++i) {
+        ComputeResult result;
+        compute_geographic_planet_ctx(&bench->arena, &result, bench->mars, &bench->context, &spec);
+        sum += result.altitudes[result.count - 1];
+        memory_arena_clear(&bench->arena);
+    }
+    bench_consume(sum);
+}
+
+static void bench_compute_geographic_planet_year_parallel(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    ComputeSpecification spec;
+    spec.date = bench->date;
+    spec.observer = bench->observer;
+    spec.steps = 8760;
+    spec.step_size = 1;
+    spec.unit = UNIT_HOURS;
+
+    f64 sum = 0.0;
+    for (usize i = 0; i < iterations; ++i) {
+        ComputeResult result;
+        compute_geographic_planet_parallel(&bench->pool, &bench->arena, &result, bench->mars, &bench->context, &spec);
+        sum += result.altitudes[result.count - 1];
+        memory_arena_clear(&bench->arena);
+    }
+    bench_consume(sum);
+}
+
+static void bench_compute_sky_snapshot_parallel(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    f64 const jdn = time_jdn(&bench->date);
+    f64 sum = 0.0;
+    for (usize i = 0; i < iterations; ++i) {
+        ComputeResult result;
+        compute_sky_snapshot_parallel(&bench->pool, &bench->arena, &result, &bench->catalog, &bench->context, jdn);
+        sum += result.altitudes[result.count - 1];
+        memory_arena_clear(&bench->arena);
+    }
+    bench_consume(sum);
+}
+
+static void bench_ephemeris_position(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    f64 const start = time_jdn(&bench->date);
+    f64 sum = 0.0;
+    for (usize i = 0; i < iterations; ++i) {
+        Equatorial const position = ephemeris_position(&bench->ephemeris, start + (f64) (i % 86400) / 86400.0);
+        sum += position.right_ascension;
+    }
+    bench_consume(sum);
+}
+
+static void bench_find_rise_transit_set_object(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    f64 const start = time_jdn(&bench->date);
+    f64 sum = 0.0;
+    for (usize i = 0; i < iterations; ++i) {
+        Object const *const object = bench->catalog.objects + (i * 97) % bench->catalog.object_count;
+        RiseTransitSet const events = find_rise_transit_set_object_ctx(object, &bench->context, start, 0.0);
+        sum += events.transit;
+    }
+    bench_consume(sum);
+}
+
+static void bench_find_rise_transit_set_catalog(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    f64 const start = time_jdn(&bench->date);
+    f64 sum = 0.0;
+    for (usize i = 0; i < iterations; ++i) {
+        RiseTransitSetResult result;
+        find_rise_transit_set_catalog(&bench->arena, &result, &bench->catalog, &bench->context, start, 0.0);
+        sum += result.events[result.count - 1].transit;
+        memory_arena_clear(&bench->arena);
+    }
+    bench_consume(sum);
+}
+
+static void bench_find_planet_events_century(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    u32 const alignment = EVENT_BODY(PLANET_MARS) | EVENT_BODY(PLANET_JUPITER) | EVENT_BODY(PLANET_SATURN);
+    EventSpecification const spec = { 2451545.0, 2451545.0 + 36525.0, 1.0, alignment };
+    usize sum = 0;
+    for (usize i = 0; i < iterations; ++i) {
+        EventResult result;
+        find_planet_events(&bench->arena, &result, &bench->catalog, &spec);
+        sum += result.count;
+        memory_arena_clear(&bench->arena);
+    }
+    bench_consume((f64) sum);
+}
+
+static void bench_spatial_index_cone(void *const state, usize const iterations) {
+    BenchState *const bench = state;
+    usize sum = 0;
+    for (usize i = 0; i < iterations; ++i) {
+        Object const *const object = bench->catalog.objects + (i * 97) % bench->catalog.object_count;
+        SpatialResult result;
+        spatial_index_cone(&bench->arena, &result, &bench->index, &object->position, 5.0);
+        sum += result.count;
+        memory_arena_clear(&bench->arena);
+    }
+    bench_consume((f64) sum);
+}
+
+int main(int argc, char **argv) {
+    BenchOptions options = bench_options_default();
+    if (!bench_options_parse(&options, argc, argv)) {
+        return EXIT_FAILURE;
+    }
+
+    BenchState state;
+    state.catalog = catalog_acquire();
+    state.arena = memory_arena_identity(ALIGNMENT8);
+    state.mars = state.catalog.planets;
+    for (usize i = 0; i < state.catalog.planet_count; ++i) {
+        if (state.catalog.planets[i].name == PLANET_MARS) {
+            state.mars = state.catalog.planets + i;
+        }
+    }
+    state.observer.latitude = 48.2;
+    state.observer.longitude = 16.37;
+    state.context = observer_context_make(&state.observer);
+    state.date = (Time){ 2024, 6, 21, 22, 30, 0, 0 };
+
+    state.pool = thread_pool_make(0);
+
+    // The index and the ephemeris live in their own arena, the benchmarks clear the shared one
+    MemoryArena index_arena = memory_arena_identity(ALIGNMENT8);
+    spatial_index_make(&index_arena, &state.index, &state.catalog, 0);
+    f64 const start = time_jdn(&state.date);
+    ephemeris_make(&index_arena, &state.ephemeris, state.mars, start, start + 1.0, 0.0, 0);
+
+    BenchCase const cases[] = {
+        { "planet_position_equatorial", bench_planet_position_equatorial, &state },
+        { "planet_positions_single", bench_planet_positions_single, &state },
+        { "planet_positions_all", bench_planet_positions_all, &state },
+        { "observe_planets", bench_observe_planets, &state },
+        { "observe_planets_context", bench_observe_planets_context, &state },
+        { "kepler_solve_batch_1024", bench_kepler_solve_batch, &state },
+        { "math_sine_cosine", bench_math_sine_cosine, &state },
+        { "math_sincos", bench_math_sincos, &state },
+        { "math_sincos_batch_1024", bench_math_sincos_batch, &state },
+        { "math_sincos_batch_1024_display", bench_math_sincos_batch_display, &state },
+        { "ephemeris_position", bench_ephemeris_position, &state },
+        { "object_position", bench_object_position, &state },
+        { "object_position_cache", bench_object_position_cache, &state },
+        { "observe_geographic", bench_observe_geographic, &state },
+        { "observe_geographic_ctx", bench_observe_geographic_ctx, &state },
+        { "time_add_minutes", bench_time_add_minutes, &state },
+        { "time_add_days", bench_time_add_days, &state },
+        { "time_add_seconds_day", bench_time_add_seconds_day, &state },
+        { "time_gmst", bench_time_gmst, &state },
+        { "time_gmst_timeline_1440", bench_time_gmst_timeline, &state },
+        { "time_iso8601_batch_1440", bench_time_iso8601_batch, &state },
+        { "memory_arena_alloc", bench_memory_arena_alloc, &state },
+        { "memory_arena_rewind", bench_memory_arena_rewind, &state },
+        { "compute_geographic_fixed_1440", bench_compute_geographic_fixed, &state },
+        { "compute_sky_snapshot", bench_compute_sky_snapshot, &state },
+        { "compute_sky_snapshot_parallel", bench_compute_sky_snapshot_parallel, &state },
+        { "compute_geographic_planet_year", bench_compute_geographic_planet_year, &state },
+        { "compute_geographic_planet_year_parallel", bench_compute_geographic_planet_year_parallel, &state },
+        { "find_rise_transit_set_object", bench_find_rise_transit_set_object, &state },
+        { "find_rise_transit_set_catalog", bench_find_rise_transit_set_catalog, &state },
+        { "find_planet_events_century", bench_find_planet_events_century, &state },
+        { "spatial_index_cone_5deg", bench_spatial_index_cone, &state },
+    };
+
+    b8 const written = bench_run_all(&options, cases, ARRAY_SIZE(cases));
+
+    thread_pool_destroy(&state.pool);
+    memory_arena_destroy(&index_arena);
+    memory_arena_destroy(&state.arena);
+    return written ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -33,34 +33,89 @@ extern "C" {
 typedef void *(*MemoryReserveFunc)(size_t);
 typedef void (*MemoryReleaseFunc)(void *);
 
-typedef enum MemoryAlignment { ALIGNMENT1 = 1, ALIGNMENT4 = 4, ALIGNMENT8 = 8 } MemoryAlignment;
+typedef enum MemoryAlignment {
+    ALIGNMENT1 = 1,
+    ALIGNMENT4 = 4,
+    ALIGNMENT8 = 8,
+    ALIGNMENT16 = 16,
+    ALIGNMENT32 = 32,
+    ALIGNMENT64 = 64,
+    ALIGNMENT_PAGE = 4096
+} MemoryAlignment;
 
+/// Source of the memory blocks of an arena
+/// @note Virtual blocks reserve address space and commit pages as the arena
+///       grows, so a large block is contiguous without occupying memory upfront.
+///       Concurrent blocks are carved from a shared concurrent arena, such
+///       arenas are only created by concurrent_arena_view.
+typedef enum MemoryBackend {
+    MEMORY_BACKEND_HEAP = 0,
+    MEMORY_BACKEND_VIRTUAL = 1,
+    MEMORY_BACKEND_CONCURRENT = 2
+} MemoryBackend;
+
+/// Specification of a memory arena
+/// @note A zero block size selects the default of the backend, a growth factor
+///       below one keeps the block size constant. The reserve and release
+///       functions are only used by the heap backend.
 typedef struct MemoryArenaSpecification {
     MemoryAlignment alignment;
     MemoryReserveFunc reserve;
     MemoryReleaseFunc release;
+    MemoryBackend backend;
+    usize block_size;
+    f64 growth_factor;
+    b8 huge_pages;
 } MemoryArenaSpecification;
 
 typedef struct MemoryBlock {
     usize size;
     usize used;
+    usize committed;
     u8 *base;
     struct MemoryBlock *before;
     usize id;
 } MemoryBlock;
 
+typedef struct ConcurrentArenaState ConcurrentArenaState;
+
 typedef struct MemoryArena {
     MemoryBlock *current;
+    MemoryBlock *free;
     MemoryAlignment alignment;
     MemoryReserveFunc reserve;
     MemoryReleaseFunc release;
+    MemoryBackend backend;
+    usize block_size;
+    usize next_block_size;
+    f64 growth_factor;
+    b8 huge_pages;
+    ConcurrentArenaState *shared;
     usize blocks;
     usize total_memory;
 } MemoryArena;
 
+/// Save-point of a memory arena, the position of the next allocation
+typedef struct MemoryArenaMark {
+    MemoryBlock *block;
+    usize used;
+} MemoryArenaMark;
+
+/// Memory arena that is shared by multiple threads
+/// @note Allocations bump an atomic offset in the current chunk, only the
+///       creation of a new chunk takes a lock. All memory is released at once
+///       when the arena is destroyed.
+typedef struct ConcurrentArena {
+    ConcurrentArenaState *state;
+} ConcurrentArena;
+
 /// Creates a new memory arena
 /// @param spec The arena specification
-/// @return Memory arena with one block
+/// @return Memory arena with one block, or without a current block if the
+///         memory cannot be reserved
+///
+/// @note The total memory of the arena counts the usable bytes of the heap
+///       blocks and the committed bytes of the virtual blocks
 SOLARIS_API MemoryArena memory_arena_make(MemoryArenaSpecification const *spec);
 
 /// Creates an identity memory arena
@@ -71,10 +126,41 @@ SOLARIS_API MemoryArena memory_arena_make(MemoryArenaSpecification const *spec);
 ///       as reserve/release functions
 SOLARIS_API MemoryArena memory_arena_identity(MemoryAlignment alignment);
 
+/// Creates a virtual memory arena
+/// @param alignment The alignment for the allocations
+/// @param reserve_size The address space of each block in bytes, 0 selects the default
+/// @return Virtual memory arena with one block, or without a current block if
+///         the address space cannot be reserved
+///
+/// @note Result buffers of any size stay contiguous within the reserved
+///       address space, pages are committed on first use
+SOLARIS_API MemoryArena memory_arena_virtual(MemoryAlignment alignment, usize reserve_size);
+
 /// Clears the memory arena by freeing all blocks
 /// @param arena The arena
 SOLARIS_API void memory_arena_clear(MemoryArena *arena);
 
+/// Resets the memory arena, keeping only its largest block
+/// @param arena The arena
+///
+/// @note Unlike clearing, the largest block stays allocated, so an arena that is
+///       reset repeatedly for similar workloads does not reserve memory again
+SOLARIS_API void memory_arena_reset(MemoryArena *arena);
+
+/// Retrieves the save-point of the current position of the arena
+/// @param arena The arena
+/// @return The save-point
+SOLARIS_API MemoryArenaMark memory_arena_mark(MemoryArena const *arena);
+
+/// Rewinds the memory arena to the save-point, releasing all allocations after it
+/// @param arena The arena
+/// @param mark The save-point, which must have been taken after the last clear or reset
+///
+/// @note The blocks that were added after the save-point stay allocated and are
+///       reused by later allocations, so a temporary scope does not reserve memory
+///       again once it is warm
+SOLARIS_API void memory_arena_rewind(MemoryArena *arena, MemoryArenaMark mark);
+
 /// Destroys the specified memory arena
 /// @param arena The arena
 SOLARIS_API void memory_arena_destroy(MemoryArena *arena);
@@ -82,9 +168,56 @@ SOLARIS_API void memory_arena_destroy(MemoryArena *arena);
 /// Allocate a block of memory in the specified arena
 /// @param arena The arena
 /// @param size The size of the requested block
-/// @return Memory void*
+/// @return Memory void*, or nil if the memory cannot be reserved
 SOLARIS_API void *memory_arena_alloc(MemoryArena *arena, usize size);
 
+/// Allocate a block of memory in the specified arena with a specific alignment
+/// @param arena The arena
+/// @param size The size of the requested block
+/// @param alignment The alignment of the address, at least the alignment of the arena
+/// @return Memory void*, or nil if the memory cannot be reserved or committed
+///
+/// @note Alignments are of absolute addresses, the bases of the blocks are aligned
+///       to the arena alignment as well
+SOLARIS_API void *memory_arena_alloc_aligned(MemoryArena *arena, usize size, MemoryAlignment alignment);
+
+/// Creates a new concurrent memory arena
+/// @param spec The specification of the arena that backs the chunks
+/// @return Concurrent memory arena, or an arena with a nil state if the first
+///         chunk cannot be reserved
+SOLARIS_API ConcurrentArena concurrent_arena_make(MemoryArenaSpecification const *spec);
+
+/// Creates a concurrent identity memory arena
+/// @param alignment The alignment for the allocations
+/// @return Concurrent memory arena with malloc and free as reserve/release functions,
+///         or an arena with a nil state if the first chunk cannot be reserved
+SOLARIS_API ConcurrentArena concurrent_arena_identity(MemoryAlignment alignment);
+
+/// Allocate a block of memory in the concurrent arena, safe to call from any thread
+/// @param arena The concurrent arena
+/// @param size The size of the requested block
+/// @return Memory void*, or nil if the backing arena cannot reserve another chunk
+SOLARIS_API void *concurrent_arena_alloc(ConcurrentArena *arena, usize size);
+
+/// Creates a memory arena for one thread, whose blocks are taken from the concurrent arena
+/// @param arena The concurrent arena
+/// @param alignment The alignment for the allocations of the view
+/// @return Memory arena that can be passed to any function that takes an arena
+///
+/// @note The view caches a chunk of the concurrent arena, so most allocations do
+///       not touch shared state. Destroying the view does not release its
+///       memory, which lives until the concurrent arena is destroyed.
+SOLARIS_API MemoryArena concurrent_arena_view(ConcurrentArena *arena, MemoryAlignment alignment);
+
+/// Retrieves the amount of memory that the concurrent arena reserved
+/// @param arena The concurrent arena
+/// @return The total memory in bytes
+SOLARIS_API usize concurrent_arena_total_memory(ConcurrentArena *arena);
+
+/// Destroys the concurrent arena and releases the memory of all views at once
+/// @param arena The concurrent arena
+SOLARIS_API void concurrent_arena_destroy(ConcurrentArena *arena);
+
 #ifdef __cplusplus
 }
 #endif
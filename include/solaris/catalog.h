@@ -25,25 +25,51 @@
 #define SOLARIS_CATALOG_H
 
 #include <solaris/arena.h>
+#include <solaris/ephemeris.h>
 #include <solaris/linear.h>
 #include <solaris/object.h>
 #include <solaris/planet.h>
+#include <solaris/thread.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/// Columnar (structure-of-arrays) view of the objects of a catalog, so that
+/// scans and transforms only touch the fields they need
+typedef struct ObjectColumns {
+    f64 *right_ascensions;
+    f64 *declinations;
+    f64 *magnitudes;
+    f64 *dimensions;
+    Classification *classifications;
+    Constellation *constellations;
+    Designation *designations;
+    usize count;
+} ObjectColumns;
+
 typedef struct Catalog {
     Planet *planets;
     Object *objects;
     usize planet_count;
     usize object_count;
+    ObjectColumns columns;
 } Catalog;
 
 /// Acquire the builtin catalog
 /// @return The builtin catalog
+///
+/// @note The columnar view of the builtin objects is filled on the first call
 SOLARIS_API Catalog catalog_acquire(void);
 
+/// Creates the columnar view of the catalog objects
+/// @param arena The arena for the dynamic memory
+/// @param catalog The catalog whose columns are created
+///
+/// @note Meant for user catalogs, the builtin catalog already has its columns
+SOLARIS_API void catalog_columns_make(MemoryArena *arena, Catalog *catalog);
+
+/// Computed series, the arrays are aligned to cache lines
 typedef struct ComputeResult {
     f64 *altitudes;
     f64 *azimuths;
@@ -58,6 +84,53 @@ typedef struct ComputeSpecification {
     TimeUnit unit;
 } ComputeSpecification;
 
+/// Compute timeline describes the samples of a computation as a linear
+/// series of julian day numbers, that is `start + step * i`
+typedef struct ComputeTimeline {
+    f64 start;
+    f64 step;
+    usize steps;
+} ComputeTimeline;
+
+/// Creates a compute timeline from the specification
+/// @param timeline The resulting timeline
+/// @param spec The compute specification
+/// @return Boolean that states whether the specification can be expressed as timeline
+///
+/// @note Months and years have no fixed length in days, specifications
+///       with these units cannot be expressed as a timeline.
+SOLARIS_API b8 compute_timeline_make(ComputeTimeline *timeline, ComputeSpecification const *spec);
+
+/// Creates a compute timeline that starts at the instant
+/// @param timeline The resulting timeline
+/// @param start The instant of the first step
+/// @param step The distance between two steps in nanoseconds
+/// @param steps The number of steps
+SOLARIS_API void compute_timeline_instant(ComputeTimeline *timeline, Instant const *start, s64 step, usize steps);
+
+/// Positions of all planets along a timeline, the arrays are indexed by step and planet name
+typedef struct PlanetSeries {
+    Equatorial *positions;
+    usize steps;
+} PlanetSeries;
+
+/// Computes the equatorial positions of all builtin planets at once
+/// @param time The date and time for the computation
+/// @param positions The computed equatorial coordinates indexed by the planet name
+///
+/// @note The entry of the earth is zero. The earth and the transforms are
+///       computed once and shared by the planets.
+SOLARIS_API void planet_positions_all(Time const *time, Equatorial positions[PLANET_COUNT]);
+
+/// Computes the equatorial positions of all builtin planets along the timeline
+/// @param arena The arena for the dynamic memory
+/// @param series The computed series, where the planet p of the step s is
+///               stored at `positions[s * PLANET_COUNT + p]`
+/// @param timeline The compute timeline
+SOLARIS_API void planet_positions_all_timeline(MemoryArena *arena,
+                                               PlanetSeries *series,
+                                               ComputeTimeline const *timeline);
+
 /// Compute the geographic position of the specified planet according
 /// to the spec
 /// @param arena The arena for the dynamic memory
@@ -69,6 +142,36 @@ SOLARIS_API void compute_geographic_planet(MemoryArena *arena,
                                            Planet const *planet,
                                            ComputeSpecification const *spec);
 
+/// Compute the geographic position of the specified planet according
+/// to the spec with a prepared observer context
+/// @param arena The arena for the dynamic memory
+/// @param result Computed result
+/// @param planet The planet for the calculation
+/// @param context The observer context
+/// @param spec The compute spec
+///
+/// @note The observer of the spec is superseded by the context
+SOLARIS_API void compute_geographic_planet_ctx(MemoryArena *arena,
+                                               ComputeResult *result,
+                                               Planet const *planet,
+                                               ObserverContext const *context,
+                                               ComputeSpecification const *spec);
+
+/// Compute the geographic position of the specified fixed object according
+/// to the specification with a prepared observer context
+/// @param arena The arena for the dynamic memory
+/// @param result Computed result
+/// @param object The object for the calculation
+/// @param context The observer context
+/// @param spec The compute specification
+///
+/// @note The observer of the specification is superseded by the context
+SOLARIS_API void compute_geographic_fixed_ctx(MemoryArena *arena,
+                                              ComputeResult *result,
+                                              Object const *object,
+                                              ObserverContext const *context,
+                                              ComputeSpecification const *spec);
+
 /// Compute the geographic position of the specified fixed object according
 /// to the specification
 /// @param arena The arena for the dynamic memory
@@ -80,6 +183,137 @@ SOLARIS_API void compute_geographic_fixed(MemoryArena *arena,
                                           Object const *object,
                                           ComputeSpecification const *spec);
 
+/// Compute the geographic position of the specified planet along the timeline
+/// @param arena The arena for the dynamic memory
+/// @param result Computed result
+/// @param planet The planet for the calculation
+/// @param context The observer context
+/// @param timeline The compute timeline
+SOLARIS_API void compute_geographic_planet_timeline(MemoryArena *arena,
+                                                    ComputeResult *result,
+                                                    Planet const *planet,
+                                                    ObserverContext const *context,
+                                                    ComputeTimeline const *timeline);
+
+/// Compute the geographic position of the specified fixed object along the timeline
+/// @param arena The arena for the dynamic memory
+/// @param result Computed result
+/// @param object The object for the calculation
+/// @param context The observer context
+/// @param timeline The compute timeline
+SOLARIS_API void compute_geographic_fixed_timeline(MemoryArena *arena,
+                                                   ComputeResult *result,
+                                                   Object const *object,
+                                                   ObserverContext const *context,
+                                                   ComputeTimeline const *timeline);
+
+/// Compute the geographic position of the planet of the ephemeris along the timeline
+/// @param arena The arena for the dynamic memory
+/// @param result Computed result
+/// @param ephemeris The ephemeris of the planet, which should cover the timeline
+/// @param context The observer context
+/// @param timeline The compute timeline
+SOLARIS_API void compute_geographic_ephemeris(MemoryArena *arena,
+                                              ComputeResult *result,
+                                              Ephemeris const *ephemeris,
+                                              ObserverContext const *context,
+                                              ComputeTimeline const *timeline);
+
+/// Compute the geographic position of every object in the catalog at one point in time
+/// @param arena The arena for the dynamic memory
+/// @param result Computed result with one entry per catalog object
+/// @param catalog The catalog
+/// @param observer The geographic coordinates of the observer
+/// @param date The date and time for the computation
+SOLARIS_API void compute_sky_snapshot(MemoryArena *arena,
+                                      ComputeResult *result,
+                                      Catalog const *catalog,
+                                      Geographic const *observer,
+                                      Time const *date);
+
+/// Compute the geographic position of every object in the catalog at one point in time
+/// with a prepared observer context
+/// @param arena The arena for the dynamic memory
+/// @param result Computed result with one entry per catalog object
+/// @param catalog The catalog
+/// @param context The observer context
+/// @param jdn The julian day number of the (local) date and time for the computation
+SOLARIS_API void compute_sky_snapshot_ctx(MemoryArena *arena,
+                                          ComputeResult *result,
+                                          Catalog const *catalog,
+                                          ObserverContext const *context,
+                                          f64 jdn);
+
+/// Compute the geographic position of the specified planet according
+/// to the spec on the threads of the pool
+/// @param pool The thread pool
+/// @param arena The arena for the dynamic memory
+/// @param result Computed result
+/// @param planet The planet for the calculation
+/// @param context The observer context
+/// @param spec The compute spec
+///
+/// @note The steps are split across the workers. Specifications that cannot
+///       be expressed as timeline are computed on the calling thread.
+SOLARIS_API void compute_geographic_planet_parallel(ThreadPool *pool,
+                                                    MemoryArena *arena,
+                                                    ComputeResult *result,
+                                                    Planet const *planet,
+                                                    ObserverContext const *context,
+                                                    ComputeSpecification const *spec);
+
+/// Compute the geographic position of the specified fixed object according
+/// to the specification on the threads of the pool
+/// @param pool The thread pool
+/// @param arena The arena for the dynamic memory
+/// @param result Computed result
+/// @param object The object for the calculation
+/// @param context The observer context
+/// @param spec The compute specification
+///
+/// @note The steps are split across the workers. Specifications that cannot
+///       be expressed as timeline are computed on the calling thread.
+SOLARIS_API void compute_geographic_fixed_parallel(ThreadPool *pool,
+                                                   MemoryArena *arena,
+                                                   ComputeResult *result,
+                                                   Object const *object,
+                                                   ObserverContext const *context,
+                                                   ComputeSpecification const *spec);
+
+/// Compute the geographic positions of the specified fixed objects according
+/// to the specification on the threads of the pool
+/// @param pool The thread pool
+/// @param arena The arena for the dynamic memory
+/// @param results Computed results, one entry per object
+/// @param objects The objects for the calculation
+/// @param count The amount of objects
+/// @param context The observer context
+/// @param spec The compute specification
+///
+/// @note The objects are split across the workers
+SOLARIS_API void compute_geographic_objects_parallel(ThreadPool *pool,
+                                                     MemoryArena *arena,
+                                                     ComputeResult *results,
+                                                     Object const *objects,
+                                                     usize count,
+                                                     ObserverContext const *context,
+                                                     ComputeSpecification const *spec);
+
+/// Compute the geographic position of every object in the catalog at one point in time
+/// on the threads of the pool
+/// @param pool The thread pool
+/// @param arena The arena for the dynamic memory
+/// @param result Computed result with one entry per catalog object
+/// @param catalog The catalog
+/// @param context The observer context
+/// @param jdn The julian day number of the (local) date and time for the computation
+SOLARIS_API void compute_sky_snapshot_parallel(ThreadPool *pool,
+                                               MemoryArena *arena,
+                                               ComputeResult *result,
+                                               Catalog const *catalog,
+                                               ObserverContext const *context,
+                                               f64 jdn);
+
 #ifdef __cplusplus
 }
 #endif
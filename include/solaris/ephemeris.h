@@ -0,0 +1,85 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Elias Engelbert Plank
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SOLARIS_EPHEMERIS_H
+#define SOLARIS_EPHEMERIS_H
+
+#include <solaris/arena.h>
+#include <solaris/linear.h>
+#include <solaris/planet.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Ephemeris caches the geocentric equatorial position of a planet as
+/// piecewise Chebyshev polynomials over segments of fixed length
+typedef struct Ephemeris {
+    Planet const *planet;
+    f64 start;
+    f64 segment_length;
+    usize segment_count;
+    usize order;
+    f64 *coefficients;
+} Ephemeris;
+
+/// Fits the ephemeris of the planet for the specified range
+/// @param arena The arena for the dynamic memory
+/// @param ephemeris The resulting ephemeris
+/// @param planet The planet
+/// @param start The julian day number of the start of the range
+/// @param end The julian day number of the end of the range
+/// @param segment_length The length of one segment in days, zero selects the default
+/// @param order The amount of coefficients per segment and axis, zero selects the default
+///
+/// @note The defaults keep the deviation from planet_position_equatorial_jdn
+///       far below a milliarcsecond for every builtin planet
+SOLARIS_API void ephemeris_make(MemoryArena *arena,
+                                Ephemeris *ephemeris,
+                                Planet const *planet,
+                                f64 start,
+                                f64 end,
+                                f64 segment_length,
+                                usize order);
+
+/// Evaluates the geocentric equatorial position of the ephemeris in cartesian coordinates
+/// @param ephemeris The ephemeris
+/// @param jdn julian day number for the evaluation
+/// @return The position in astronomical units
+///
+/// @note Outside of the fitted range, the position of the planet is computed directly
+SOLARIS_API Vector3 ephemeris_vector(Ephemeris const *ephemeris, f64 jdn);
+
+/// Evaluates the equatorial position of the ephemeris
+/// @param ephemeris The ephemeris
+/// @param jdn julian day number for the evaluation
+/// @return The equatorial coordinates
+///
+/// @note Outside of the fitted range, the position of the planet is computed directly
+SOLARIS_API Equatorial ephemeris_position(Ephemeris const *ephemeris, f64 jdn);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif// SOLARIS_EPHEMERIS_H
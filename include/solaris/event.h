@@ -0,0 +1,171 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Elias Engelbert Plank
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SOLARIS_EVENT_H
+#define SOLARIS_EVENT_H
+
+#include <solaris/arena.h>
+#include <solaris/catalog.h>
+#include <solaris/linear.h>
+#include <solaris/object.h>
+#include <solaris/planet.h>
+#include <solaris/time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Horizon crossings and the upper culmination of a body within one day,
+/// all points in time are (local) julian day numbers
+typedef struct RiseTransitSet {
+    f64 rise;
+    f64 transit;
+    f64 set;
+    f64 transit_altitude;
+    b8 rises;
+    b8 transits;
+    b8 sets;
+    b8 circumpolar;
+} RiseTransitSet;
+
+typedef struct RiseTransitSetResult {
+    RiseTransitSet *events;
+    usize count;
+} RiseTransitSetResult;
+
+/// Finds the rise, transit and set of the fixed object on the specified day
+/// @param object The object
+/// @param observer The geographic coordinates of the observer
+/// @param date The day of the search, which starts at local midnight
+/// @param horizon The altitude of the horizon in degrees
+/// @return The events of the day
+SOLARIS_API RiseTransitSet find_rise_transit_set_object(Object const *object,
+                                                        Geographic const *observer,
+                                                        Time const *date,
+                                                        f64 horizon);
+
+/// Finds the rise, transit and set of the planet on the specified day
+/// @param planet The planet
+/// @param observer The geographic coordinates of the observer
+/// @param date The day of the search, which starts at local midnight
+/// @param horizon The altitude of the horizon in degrees
+/// @return The events of the day
+SOLARIS_API RiseTransitSet find_rise_transit_set_planet(Planet const *planet,
+                                                        Geographic const *observer,
+                                                        Time const *date,
+                                                        f64 horizon);
+
+/// Finds the rise, transit and set of the fixed object within one day
+/// @param object The object
+/// @param context The observer context
+/// @param jdn The julian day number of the (local) start of the search
+/// @param horizon The altitude of the horizon in degrees
+/// @return The events within one day after the start
+///
+/// @note The horizon crossings are bracketed by hourly samples and refined with
+///       brent's method, which takes a few dozen evaluations for all events
+SOLARIS_API RiseTransitSet find_rise_transit_set_object_ctx(Object const *object,
+                                                            ObserverContext const *context,
+                                                            f64 jdn,
+                                                            f64 horizon);
+
+/// Finds the rise, transit and set of the planet within one day
+/// @param planet The planet
+/// @param context The observer context
+/// @param jdn The julian day number of the (local) start of the search
+/// @param horizon The altitude of the horizon in degrees
+/// @return The events within one day after the start
+SOLARIS_API RiseTransitSet find_rise_transit_set_planet_ctx(Planet const *planet,
+                                                            ObserverContext const *context,
+                                                            f64 jdn,
+                                                            f64 horizon);
+
+/// Finds the rise, transit and set of every object in the catalog within one day
+/// @param arena The arena for the dynamic memory
+/// @param result The events with one entry per catalog object
+/// @param catalog The catalog
+/// @param context The observer context
+/// @param jdn The julian day number of the (local) start of the search
+/// @param horizon The altitude of the horizon in degrees
+///
+/// @note The transforms of the hourly samples are shared by all objects
+SOLARIS_API void find_rise_transit_set_catalog(MemoryArena *arena,
+                                               RiseTransitSetResult *result,
+                                               Catalog const *catalog,
+                                               ObserverContext const *context,
+                                               f64 jdn,
+                                               f64 horizon);
+
+/// Bit of a planet in the body mask of an event
+#define EVENT_BODY(planet) (1u << (planet))
+
+/// Bit of the sun in the body mask of an event
+#define EVENT_BODY_SUN (1u << PLANET_COUNT)
+
+typedef enum EventKind { EVENT_CONJUNCTION, EVENT_OPPOSITION, EVENT_ALIGNMENT } EventKind;
+
+/// Event of the planets, the separation is the angular distance of the two
+/// bodies of a conjunction, the elongation of the planet at opposition, and
+/// the largest angular distance between the bodies of an alignment
+typedef struct Event {
+    EventKind kind;
+    f64 jdn;
+    f64 separation;
+    u32 bodies;
+} Event;
+
+typedef struct EventResult {
+    Event *events;
+    usize count;
+} EventResult;
+
+typedef struct EventSpecification {
+    f64 start;
+    f64 end;
+    f64 tolerance;
+    u32 alignment;
+} EventSpecification;
+
+/// Finds the conjunctions, oppositions and alignments of the planets and the sun
+/// @param arena The arena for the dynamic memory
+/// @param result The events ordered by time
+/// @param catalog The catalog with the planets
+/// @param spec The julian day numbers of the range, the angular tolerance of
+///             conjunctions and alignments in degrees, and the body mask of the
+///             alignment (zero disables the alignment search)
+///
+/// @note The separations are sampled once per day and shared by all pairs of
+///       bodies. Local extrema are bracketed by the sign change of the difference
+///       of consecutive samples and refined with a golden section search.
+///       Extrema within one day of the range boundaries are not reported.
+///       If the arena cannot provide the memory for the events, the result is empty.
+SOLARIS_API void find_planet_events(MemoryArena *arena,
+                                    EventResult *result,
+                                    Catalog const *catalog,
+                                    EventSpecification const *spec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif// SOLARIS_EVENT_H
@@ -110,6 +110,14 @@ SOLARIS_API Matrix3x3 matrix3x3_mul_chain(Matrix3x3 const *chain, usize count);
 /// @return The multiplication result
 SOLARIS_API Vector3 matrix3x3_mul_vector3(Matrix3x3 const *left, Vector3 const *right);
 
+/// Multiplies the matrix with arrays of vector components in place
+/// @param left The matrix
+/// @param x The x components
+/// @param y The y components
+/// @param z The z components
+/// @param count The number of vectors
+SOLARIS_API void matrix3x3_mul_vector3_batch(Matrix3x3 const *left, f64 *x, f64 *y, f64 *z, usize count);
+
 /// Represents an axis of rotation in 3-dimensional space
 typedef enum RotationAxis { ROTATION_AXIS_X, ROTATION_AXIS_Y, ROTATION_AXIS_Z } RotationAxis;
 
@@ -152,6 +160,42 @@ SOLARIS_API Vector3 vector3_from_equatorial(Equatorial const *equatorial);
 /// @return The transformed spherical coordinates
 SOLARIS_API Equatorial equatorial_from_vector3(Vector3 const *vector);
 
+/// Transform arrays of equatorial coordinates to arrays of rectangular coordinates
+/// @param right_ascension The right ascensions in degrees
+/// @param declination The declinations in degrees
+/// @param distance The distances, nil for unit vectors
+/// @param x The resulting x coordinates
+/// @param y The resulting y coordinates
+/// @param z The resulting z coordinates
+/// @param count The number of coordinates
+///
+/// @note Uses vectorized polynomial kernels, the best instruction set is selected at runtime
+SOLARIS_API void vector3_from_equatorial_batch(f64 const *right_ascension,
+                                               f64 const *declination,
+                                               f64 const *distance,
+                                               f64 *x,
+                                               f64 *y,
+                                               f64 *z,
+                                               usize count);
+
+/// Transform arrays of rectangular coordinates to arrays of equatorial coordinates
+/// @param x The x coordinates
+/// @param y The y coordinates
+/// @param z The z coordinates
+/// @param right_ascension The resulting right ascensions in degrees
+/// @param declination The resulting declinations in degrees
+/// @param distance The resulting distances, may be nil
+/// @param count The number of coordinates
+///
+/// @note Uses vectorized polynomial kernels, the best instruction set is selected at runtime
+SOLARIS_API void equatorial_from_vector3_batch(f64 const *x,
+                                               f64 const *y,
+                                               f64 const *z,
+                                               f64 *right_ascension,
+                                               f64 *declination,
+                                               f64 *distance,
+                                               usize count);
+
 /// Transforms Equatorial coordinates to Horizontal ones
 /// @param declination declination in degrees
 /// @param hour_angle Hour angle (by Greenwich Mean Sidereal Time) in degrees
@@ -166,6 +210,94 @@ SOLARIS_API Horizontal local_equatorial_to_horizontal(f64 declination, f64 hour_
 /// @return the Computed horizontal coordinates
 SOLARIS_API Horizontal observe_geographic(Equatorial const *equatorial, Geographic const *observer, Time const *date);
 
+/// Observer context holds the observer dependent quantities that stay the
+/// same between observations, so that observing is pure arithmetic
+typedef struct ObserverContext {
+    Geographic observer;
+    f64 sin_latitude;
+    f64 cos_latitude;
+    s64 utc_offset;
+} ObserverContext;
+
+/// Creates an observer context for the specified observer
+/// @param observer The geographic coordinates of the observer
+/// @return Observer context
+///
+/// @note The UTC offset (local - UTC in seconds) is resolved once at creation,
+///       with the same caveats as `time_utc_local`.
+SOLARIS_API ObserverContext observer_context_make(Geographic const *observer);
+
+/// Creates an observer context for the specified observer with the explicit UTC offset
+/// @param observer The geographic coordinates of the observer
+/// @param utc_offset The offset of the local time to UTC in seconds, positive east of Greenwich
+/// @return Observer context
+SOLARIS_API ObserverContext observer_context_make_offset(Geographic const *observer, s64 utc_offset);
+
+/// Time context holds all quantities that are derived from a single instant,
+/// so that evaluating many planets and objects at the same instant does the
+/// time dependent work only once, see `time_context_make`
+/// @note The sidereal time and the obliquity of date are in degrees. The
+///       precession is from J2000 to the equinox of date, the planet transform
+///       fuses it with the J2000 ecliptic to equatorial frame, and the earth is
+///       the heliocentric ecliptic position of the EM-barycenter.
+typedef struct TimeContext {
+    f64 jdn;
+    f64 jc;
+    f64 mjdn;
+    f64 gmst;
+    f64 obliquity;
+    Matrix3x3 precession;
+    Matrix3x3 object_precession;
+    Matrix3x3 planet_transform;
+    Vector3 earth;
+} TimeContext;
+
+/// Computes the Horizontal position of an object with spherical coordinates
+/// @param equatorial The spherical coordinates of the object
+/// @param context The observer context
+/// @param date The date and time for the computation
+/// @return the Computed horizontal coordinates
+SOLARIS_API Horizontal observe_geographic_ctx(Equatorial const *equatorial,
+                                              ObserverContext const *context,
+                                              Time const *date);
+
+/// Computes the Horizontal position of an object with spherical coordinates
+/// @param equatorial The spherical coordinates of the object
+/// @param context The observer context
+/// @param jdn The julian day number of the (local) date and time for the computation
+/// @return the Computed horizontal coordinates
+SOLARIS_API Horizontal observe_geographic_jdn(Equatorial const *equatorial, ObserverContext const *context, f64 jdn);
+
+/// Computes the Horizontal position of an object with spherical coordinates
+/// @param equatorial The spherical coordinates of the object
+/// @param context The observer context
+/// @param time The time context of the instant, made with the UTC offset of the observer
+/// @return the Computed horizontal coordinates
+SOLARIS_API Horizontal observe_geographic_context(Equatorial const *equatorial,
+                                                  ObserverContext const *context,
+                                                  TimeContext const *time);
+
+/// Computes the local mean sidereal time of the observer
+/// @param context The observer context
+/// @param jdn The julian day number of the (local) date and time
+/// @return Local mean sidereal time in degrees
+SOLARIS_API f64 observer_context_lmst(ObserverContext const *context, f64 jdn);
+
+/// Creates a matrix that transforms rectangular equatorial coordinates
+/// with the equinox of date to the horizontal system of the observer
+/// @param context The observer context
+/// @param jdn The julian day number of the (local) date and time
+/// @return transformation matrix
+///
+/// @note The x-axis of the horizontal system points south, the y-axis west
+///       and the z-axis to the zenith, see `horizontal_from_vector3`
+SOLARIS_API Matrix3x3 matrix3x3_horizontal(ObserverContext const *context, f64 jdn);
+
+/// Transform a Vector3 of the horizontal system to horizontal coordinates
+/// @param vector The rectangular coordinates
+/// @return The transformed horizontal coordinates
+SOLARIS_API Horizontal horizontal_from_vector3(Vector3 const *vector);
+
 #ifdef __cplusplus
 }
 #endif
@@ -37,6 +37,27 @@ extern "C" {
 #define ARCS (3600.0 * 180.0 / PI)
 #define SECONDS_PER_DAY 86400.0
 
+/// Accuracy tiers of the trigonometric functions
+typedef enum MathPrecision {
+    /// Full double precision
+    MATH_PRECISION_FULL,
+    /// Angles accurate to about 1e-9 degrees
+    MATH_PRECISION_HIGH,
+    /// Angles accurate to about 1e-5 degrees, which is enough for rendering
+    MATH_PRECISION_DISPLAY
+} MathPrecision;
+
+/// Selects the accuracy tier of the trigonometric functions
+/// @param precision The accuracy tier
+///
+/// @note The tier is process-wide and should be selected before computations start.
+///       The initial tier is chosen at build time with SOLARIS_MATH_PRECISION.
+SOLARIS_API void math_precision_set(MathPrecision precision);
+
+/// Retrieves the accuracy tier of the trigonometric functions
+/// @return The accuracy tier
+SOLARIS_API MathPrecision math_precision_get(void);
+
 /// Retrieves the absolute value
 /// @param x The value
 /// @return Absolute value of x
@@ -83,6 +104,23 @@ SOLARIS_API f64 math_sine(f64 angle);
 /// @return The cosine value
 SOLARIS_API f64 math_cosine(f64 angle);
 
+/// Retrieves the sine and cosine values of the specified angle at once
+/// @param angle The angle in degrees
+/// @param sine The sine value
+/// @param cosine The cosine value
+///
+/// @note Uses polynomial kernels with an exact reduction of the degrees in all tiers
+SOLARIS_API void math_sincos(f64 angle, f64 *sine, f64 *cosine);
+
+/// Retrieves the sine and cosine values of arrays of angles
+/// @param angle The angles in degrees
+/// @param sine The resulting sine values
+/// @param cosine The resulting cosine values
+/// @param count The number of angles
+///
+/// @note Uses vectorized polynomial kernels, the best instruction set is selected at runtime
+SOLARIS_API void math_sincos_batch(f64 const *angle, f64 *sine, f64 *cosine, usize count);
+
 /// Retrieves the tangent value of the specified angle
 /// @param angle The angle
 /// @return The tangent value
@@ -111,6 +149,15 @@ SOLARIS_API f64 math_arc_tangent(f64 x);
 /// @note This checks for all four areas of the unit circle
 SOLARIS_API f64 math_arc_tangent2(f64 y, f64 x);
 
+/// Retrieves the tangent angles of arrays of distances
+/// @param y The y distances
+/// @param x The x distances
+/// @param angle The resulting angles in degrees
+/// @param count The number of angles
+///
+/// @note Uses vectorized polynomial kernels, the best instruction set is selected at runtime
+SOLARIS_API void math_arc_tangent2_batch(f64 const *y, f64 const *x, f64 *angle, usize count);
+
 /// Converts degrees, arc minutes and arc seconds to fractional degrees
 /// @param degrees The amount of degrees
 /// @param arc_minutes The amount of arc minutes
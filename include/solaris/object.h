@@ -26,6 +26,7 @@
 
 #include <solaris/linear.h>
 #include <solaris/time.h>
+#include <solaris/transform.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -175,12 +176,38 @@ typedef struct Object {
     f64 magnitude;
 } Object;
 
+/// Creates the precession matrix from the catalog epoch of fixed objects to the equinox of date
+/// @param jdn Julian day number of the equinox of date
+/// @return transformation matrix
+SOLARIS_API Matrix3x3 object_precession_jdn(f64 jdn);
+
 /// Computes the precessed equatorial position of the fixed object with the equinox of date
 /// @param body The body of which the position shall be computed
 /// @param date_time Date for computation
 /// @return precessed position
 SOLARIS_API Equatorial object_position(Object const *body, Time const *date_time);
 
+/// Computes the precessed equatorial position of the fixed object with the equinox of date
+/// @param body The body of which the position shall be computed
+/// @param jdn Julian day number for computation
+/// @return precessed position
+SOLARIS_API Equatorial object_position_jdn(Object const *body, f64 jdn);
+
+/// Computes the precessed equatorial position of the fixed object with the equinox of date
+/// @param body The body of which the position shall be computed
+/// @param cache The cache of the precession transforms
+/// @param jdn Julian day number for computation
+/// @return precessed position
+///
+/// @note Loops over many objects at the same epoch build the precession only once
+SOLARIS_API Equatorial object_position_cache(Object const *body, TransformCache *cache, f64 jdn);
+
+/// Computes the precessed equatorial position of the fixed object with the equinox of date
+/// @param body The body of which the position shall be computed
+/// @param time The time context of the instant
+/// @return precessed position
+SOLARIS_API Equatorial object_position_context(Object const *body, TimeContext const *time);
+
 /// Retrieves a string representation of the provided classification
 /// @param classification The classification
 /// @return String representation of the classification
@@ -27,11 +27,16 @@
 #include <solaris/linear.h>
 #include <solaris/math.h>
 #include <solaris/time.h>
+#include <solaris/transform.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/// Fixed number of newton iterations of the batch kepler solver, the error of
+/// the eccentric anomaly is below 1e-14 radians for eccentricities up to 0.99
+#define KEPLER_ITERATIONS 8
+
 typedef enum PlanetName {
     PLANET_MERCURY,
     PLANET_VENUS,
@@ -65,12 +70,139 @@ typedef struct Planet {
 /// @return the computed orbital coordinates
 SOLARIS_API Elements planet_position_orbital(Planet const *planet, Time const *date);
 
+/// Computes the orbital position of the planet
+/// @param planet The planet
+/// @param jdn julian day number for the computation
+/// @return the computed orbital coordinates
+SOLARIS_API Elements planet_position_orbital_jdn(Planet const *planet, f64 jdn);
+
+/// Solves kepler's equation M = E - e * sin(E) for arrays of mean anomalies and eccentricities
+/// @param mean_anomaly The mean anomalies in radians
+/// @param eccentricity The eccentricities of the elliptic orbits
+/// @param eccentric_anomaly The resulting eccentric anomalies in radians
+/// @param count The number of orbits
+///
+/// @note Starts from the guess of Danby and runs KEPLER_ITERATIONS newton steps on
+///       every element, the best instruction set is selected at runtime. For
+///       eccentricities up to 0.99, the error of the eccentric anomaly is below
+///       1e-14 rad plus the rounding of adding back the full turns of M.
+SOLARIS_API void kepler_solve_batch(f64 const *mean_anomaly,
+                                    f64 const *eccentricity,
+                                    f64 *eccentric_anomaly,
+                                    usize count);
+
+/// Computes the heliocentric ecliptic position of the earth
+/// @param julian_centuries julian centuries since J2000 for the computation
+/// @return the position of the EM-barycenter in astronomical units
+SOLARIS_API Vector3 position_of_earth(f64 julian_centuries);
+
 /// Computes the equatorial position of the planet
 /// @param planet The planet
 /// @param date date and time for the computation
 /// @return the computed equatorial coordinates
 SOLARIS_API Equatorial planet_position_equatorial(Planet const *planet, Time const *date);
 
+/// Computes the equatorial position of the planet
+/// @param planet The planet
+/// @param jdn julian day number for the computation
+/// @return the computed equatorial coordinates
+SOLARIS_API Equatorial planet_position_equatorial_jdn(Planet const *planet, f64 jdn);
+
+/// Computes the geocentric equatorial position of the planet in cartesian coordinates
+/// @param planet The planet
+/// @param jdn julian day number for the computation
+/// @return the computed position in astronomical units
+SOLARIS_API Vector3 planet_position_vector_jdn(Planet const *planet, f64 jdn);
+
+/// Computes the geocentric equatorial position of the planet in cartesian coordinates
+/// @param planet The planet
+/// @param cache The cache of the precession and frame transforms
+/// @param jdn julian day number for the computation
+/// @return the computed position in astronomical units
+///
+/// @note The transform is shared by all planets and the sun, so positions of
+///       several bodies at the same epoch only build it once
+SOLARIS_API Vector3 planet_position_vector_cache(Planet const *planet, TransformCache *cache, f64 jdn);
+
+/// Computes the equatorial position of the planet
+/// @param planet The planet
+/// @param cache The cache of the precession and frame transforms
+/// @param jdn julian day number for the computation
+/// @return the computed equatorial coordinates
+SOLARIS_API Equatorial planet_position_equatorial_cache(Planet const *planet, TransformCache *cache, f64 jdn);
+
+/// Computes the geocentric equatorial position of the planet in cartesian coordinates
+/// @param planet The planet
+/// @param time The time context of the instant
+/// @return the computed position in astronomical units
+///
+/// @note The position of the earth and the transforms are taken from the time context
+SOLARIS_API Vector3 planet_position_vector_context(Planet const *planet, TimeContext const *time);
+
+/// Computes the equatorial position of the planet
+/// @param planet The planet
+/// @param time The time context of the instant
+/// @return the computed equatorial coordinates
+SOLARIS_API Equatorial planet_position_equatorial_context(Planet const *planet, TimeContext const *time);
+
+/// Computes the geocentric equatorial positions of several planets in cartesian coordinates
+/// @param planets The planets
+/// @param count The number of planets
+/// @param jdn julian day number for the computation
+/// @param positions The computed positions in astronomical units, one per planet
+///
+/// @note The position of the earth and the transforms are computed once for all planets,
+///       the orbits are solved in vectorized batches
+SOLARIS_API void planet_positions_vector_jdn(Planet const *planets, usize count, f64 jdn, Vector3 *positions);
+
+/// Computes the equatorial positions of several planets
+/// @param planets The planets
+/// @param count The number of planets
+/// @param jdn julian day number for the computation
+/// @param positions The computed equatorial coordinates, one per planet
+SOLARIS_API void planet_positions_equatorial_jdn(Planet const *planets, usize count, f64 jdn, Equatorial *positions);
+
+/// Computes the equatorial positions of several planets along a series of julian day numbers
+/// @param planets The planets
+/// @param count The number of planets
+/// @param start julian day number of the first step
+/// @param step The distance between two steps in days
+/// @param steps The number of steps
+/// @param positions The computed equatorial coordinates, where the planet i of the step s
+///                  is stored at `positions[s * count + i]`
+SOLARIS_API void planet_positions_equatorial_series(Planet const *planets,
+                                                    usize count,
+                                                    f64 start,
+                                                    f64 step,
+                                                    usize steps,
+                                                    Equatorial *positions);
+
+/// Computes the equatorial position of the sun
+/// @param jdn julian day number for the computation
+/// @return the computed equatorial coordinates
+SOLARIS_API Equatorial sun_position_equatorial_jdn(f64 jdn);
+
+/// Computes the geocentric equatorial position of the sun in cartesian coordinates
+/// @param jdn julian day number for the computation
+/// @return the computed position in astronomical units
+SOLARIS_API Vector3 sun_position_vector_jdn(f64 jdn);
+
+/// Computes the geocentric equatorial position of the sun in cartesian coordinates
+/// @param cache The cache of the precession and frame transforms
+/// @param jdn julian day number for the computation
+/// @return the computed position in astronomical units
+SOLARIS_API Vector3 sun_position_vector_cache(TransformCache *cache, f64 jdn);
+
+/// Computes the geocentric equatorial position of the sun in cartesian coordinates
+/// @param time The time context of the instant
+/// @return the computed position in astronomical units
+SOLARIS_API Vector3 sun_position_vector_context(TimeContext const *time);
+
+/// Computes the equatorial position of the sun
+/// @param time The time context of the instant
+/// @return the computed equatorial coordinates
+SOLARIS_API Equatorial sun_position_equatorial_context(TimeContext const *time);
+
 /// Retrieves the name of the planet in string representation
 /// @param name The name of the planet
 /// @return The name in string representation
@@ -0,0 +1,121 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Elias Engelbert Plank
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SOLARIS_PLATE_H
+#define SOLARIS_PLATE_H
+
+#include <solaris/arena.h>
+#include <solaris/catalog.h>
+#include <solaris/linear.h>
+#include <solaris/spatial.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Geometric hash index of the catalog for plate solving
+/// @note Every object forms triangles with pairs of its nearest neighbours. The
+///       triangles are hashed by the ratios of their sides, which do not change
+///       under rotation and scale, and sorted by hash bin.
+typedef struct PlateIndex {
+    SpatialIndex spatial;
+    usize object_count;
+    f64 *x;
+    f64 *y;
+    f64 *z;
+    usize triangle_count;
+    u32 *offsets;
+    u32 *triangles;
+    f64 *ratios;
+} PlateIndex;
+
+/// Detected star centroid in pixel coordinates
+typedef struct PlateStar {
+    f64 x;
+    f64 y;
+} PlateStar;
+
+/// Image properties and search limits for plate solving
+typedef struct PlateSpecification {
+    f64 width;
+    f64 height;
+    f64 scale_min;
+    f64 scale_max;
+    f64 tolerance;
+    usize stars;
+} PlateSpecification;
+
+/// Solution of a plate, the tangent point of the image center and the
+/// similarity transform between pixels and the tangent plane. The rotation
+/// is the angle from east to the image x-axis towards north.
+typedef struct PlateSolution {
+    Equatorial center;
+    f64 rotation;
+    f64 scale;
+    f64 center_x;
+    f64 center_y;
+    usize matches;
+    b8 flipped;
+    b8 solved;
+} PlateSolution;
+
+/// Creates the plate solving index of the catalog objects
+/// @param arena The arena for the dynamic memory
+/// @param index The resulting index
+/// @param catalog The catalog
+/// @param neighbours The amount of nearest neighbours per object, values below 2 select
+///                   the default, since triangles need a pair of neighbours
+SOLARIS_API void plate_index_make(MemoryArena *arena, PlateIndex *index, Catalog const *catalog, usize neighbours);
+
+/// Solves the plate from the detected stars without prior position
+/// @param arena The arena for the scratch memory, which is released before returning
+/// @param index The plate solving index
+/// @param stars The detected stars, brightest first
+/// @param star_count The amount of detected stars
+/// @param spec The image size in pixels, the range of the scale in arcseconds per
+///             pixel (zero for unbounded), the match tolerance in pixels and the
+///             amount of brightest stars that form triangles (zero for the defaults)
+/// @return The solution, which states whether the plate is solved
+///
+/// @note Triangles of the brightest stars are looked up in the index. Every
+///       candidate is verified by projecting the catalog objects of the field
+///       onto the image, the first candidate with enough matches is refined
+///       with all matched stars.
+SOLARIS_API PlateSolution plate_solve(MemoryArena *arena,
+                                      PlateIndex const *index,
+                                      PlateStar const *stars,
+                                      usize star_count,
+                                      PlateSpecification const *spec);
+
+/// Retrieves the equatorial position of the pixel
+/// @param solution The plate solution
+/// @param x The x-coordinate of the pixel
+/// @param y The y-coordinate of the pixel
+/// @return The equatorial position in the frame of the catalog
+SOLARIS_API Equatorial plate_solution_position(PlateSolution const *solution, f64 x, f64 y);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif// SOLARIS_PLATE_H
@@ -26,11 +26,17 @@
 
 #include <solaris/arena.h>
 #include <solaris/catalog.h>
+#include <solaris/ephemeris.h>
+#include <solaris/event.h>
 #include <solaris/linear.h>
 #include <solaris/math.h>
 #include <solaris/object.h>
 #include <solaris/planet.h>
+#include <solaris/plate.h>
+#include <solaris/spatial.h>
+#include <solaris/thread.h>
 #include <solaris/time.h>
+#include <solaris/transform.h>
 #include <solaris/types.h>
 
 #endif// SOLARIS_H
@@ -0,0 +1,109 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Elias Engelbert Plank
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SOLARIS_SPATIAL_H
+#define SOLARIS_SPATIAL_H
+
+#include <solaris/arena.h>
+#include <solaris/catalog.h>
+#include <solaris/linear.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Spatial index of catalog objects on the celestial sphere
+/// @note The sphere is projected onto the six faces of a cube, each face is a
+///       quadtree of the specified depth. Objects are sorted by their leaf cell
+///       in morton order, so every quadtree node covers a contiguous range.
+typedef struct SpatialIndex {
+    usize depth;
+    usize count;
+    u32 *offsets;
+    u32 *indices;
+    f64 *x;
+    f64 *y;
+    f64 *z;
+} SpatialIndex;
+
+/// Result of a spatial query
+typedef struct SpatialResult {
+    usize *indices;
+    usize count;
+} SpatialResult;
+
+/// Creates the spatial index of the catalog objects
+/// @param arena The arena for the dynamic memory
+/// @param index The resulting index
+/// @param catalog The catalog
+/// @param depth The depth of the quadtree of each cube face, 0 selects a depth by the object count
+///
+/// @note Objects are indexed with their catalog positions, queries use the same frame
+SOLARIS_API void spatial_index_make(MemoryArena *arena, SpatialIndex *index, Catalog const *catalog, usize depth);
+
+/// Retrieves all objects within the cone
+/// @param arena The arena for the dynamic memory
+/// @param result The indices of the objects in the catalog
+/// @param index The spatial index
+/// @param center The center of the cone
+/// @param radius The radius of the cone in degrees
+SOLARIS_API void spatial_index_cone(MemoryArena *arena,
+                                    SpatialResult *result,
+                                    SpatialIndex const *index,
+                                    Equatorial const *center,
+                                    f64 radius);
+
+/// Retrieves all objects within the convex spherical polygon
+/// @param arena The arena for the dynamic memory
+/// @param result The indices of the objects in the catalog
+/// @param index The spatial index
+/// @param vertices The vertices of the polygon, connected by great circles
+/// @param vertex_count The number of vertices, at least three
+///
+/// @note The polygon must be convex and smaller than a hemisphere, the
+///       orientation of the vertices does not matter. Fewer than three
+///       vertices or consecutive vertices that are equal or antipodal yield
+///       an empty result.
+SOLARIS_API void spatial_index_polygon(MemoryArena *arena,
+                                       SpatialResult *result,
+                                       SpatialIndex const *index,
+                                       Equatorial const *vertices,
+                                       usize vertex_count);
+
+/// Retrieves the nearest objects to the specified position
+/// @param arena The arena for the dynamic memory
+/// @param result The indices of the objects in the catalog, nearest first
+/// @param index The spatial index
+/// @param center The position
+/// @param count The number of requested objects
+SOLARIS_API void spatial_index_nearest(MemoryArena *arena,
+                                       SpatialResult *result,
+                                       SpatialIndex const *index,
+                                       Equatorial const *center,
+                                       usize count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif// SOLARIS_SPATIAL_H
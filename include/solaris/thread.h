@@ -0,0 +1,82 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Elias Engelbert Plank
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SOLARIS_THREAD_H
+#define SOLARIS_THREAD_H
+
+#include <solaris/arena.h>
+#include <solaris/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Processes the range [begin, end) of a parallel job
+/// @param data The job data
+/// @param begin First index of the range
+/// @param end One past the last index of the range
+/// @param arena The arena of the executing worker for scratch memory
+typedef void (*ThreadTaskFunc)(void *data, usize begin, usize end, MemoryArena *arena);
+
+typedef struct ThreadPoolState ThreadPoolState;
+
+/// Thread pool with persistent workers, the calling thread takes part
+/// in every job as the first worker
+typedef struct ThreadPool {
+    usize workers;
+    ThreadPoolState *state;
+} ThreadPool;
+
+/// Creates a new thread pool
+/// @param workers The amount of workers including the calling thread, zero
+///                selects the amount of online processors
+/// @return Thread pool
+///
+/// @note If threads cannot be created, the pool runs with fewer workers. If the
+///       state of the pool cannot be allocated, the pool has no workers and
+///       runs every job on the calling thread.
+SOLARIS_API ThreadPool thread_pool_make(usize workers);
+
+/// Destroys the thread pool and joins its threads
+/// @param pool The thread pool
+SOLARIS_API void thread_pool_destroy(ThreadPool *pool);
+
+/// Splits the range [0, count) into one contiguous slice per worker, at most
+/// one slice per item, and waits until every slice is processed
+/// @param pool The thread pool
+/// @param count The amount of items
+/// @param task The function that processes a slice
+/// @param data The job data that is passed to the task
+///
+/// @note Every worker owns an arena for scratch memory, which is reset
+///       once the job is finished. Results must be written to memory that
+///       is owned by the caller, each task into its own slice. A pool runs
+///       one job at a time, it must not be entered from two threads at once
+///       and tasks must not call thread_pool_for on their own pool.
+SOLARIS_API void thread_pool_for(ThreadPool *pool, usize count, ThreadTaskFunc task, void *data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif// SOLARIS_THREAD_H
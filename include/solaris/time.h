@@ -44,33 +44,118 @@ typedef struct Time {
 
 typedef enum TimeUnit { UNIT_SECONDS, UNIT_MINUTES, UNIT_HOURS, UNIT_DAYS, UNIT_MONTHS, UNIT_YEARS } TimeUnit;
 
+/// Number of nanoseconds of a day
+#define INSTANT_NANOSECONDS_PER_DAY ((s64) 86400000000000)
+
+/// Linear point in time, split into the modified julian day and the nanoseconds
+/// of that day, so that arithmetic is exact and takes constant time
+typedef struct Instant {
+    s64 day;
+    s64 nanosecond;
+} Instant;
+
 /// Add the specified amount to the DateTime instance
 /// @param date The dateTime instance that is modified
 /// @param amount The amount to add
 /// @param unit The unit of time that is added
 SOLARIS_API void time_add(Time *date, s64 amount, TimeUnit unit);
 
+/// Creates the instant of the date
+/// @param date The date, fields out of range carry into the next larger unit
+/// @return The instant
+///
+/// @note Dates up to 1582-10-04 are in the julian calendar, later ones in the gregorian calendar
+SOLARIS_API Instant instant_from_time(Time const *date);
+
+/// Converts the instant to a date
+/// @param instant The instant
+/// @return The date, where the part below milliseconds is truncated
+SOLARIS_API Time instant_to_time(Instant const *instant);
+
+/// Creates the instant of the julian day number
+/// @param jdn The julian day number
+/// @return The instant
+SOLARIS_API Instant instant_from_jdn(f64 jdn);
+
+/// Calculates the julian day number of the instant
+/// @param instant The instant
+/// @return Julian day number
+SOLARIS_API f64 instant_jdn(Instant const *instant);
+
+/// Calculates the mean julian day number of the instant
+/// @param instant The instant
+/// @return Mean julian day number
+SOLARIS_API f64 instant_mjdn(Instant const *instant);
+
+/// Adds the number of nanoseconds to the instant
+/// @param instant The instant that is modified
+/// @param nanoseconds The number of nanoseconds
+SOLARIS_API void instant_add_nanoseconds(Instant *instant, s64 nanoseconds);
+
+/// Adds the specified amount to the instant
+/// @param instant The instant that is modified
+/// @param amount The amount to add
+/// @param unit The unit of time that is added
+///
+/// @note Seconds to days take constant time, months and years go through the calendar
+SOLARIS_API void instant_add(Instant *instant, s64 amount, TimeUnit unit);
+
+/// Calculates the difference of the two instants in seconds
+/// @param a First instant
+/// @param b Second instant
+/// @return Difference in seconds (b - a)
+SOLARIS_API f64 instant_difference(Instant const *a, Instant const *b);
+
+/// Compares the two instants
+/// @param left The left instant
+/// @param right The right instant
+/// @return A value that is < 0 if the left < right, 0 if left == right, > 0 if left > right
+SOLARIS_API s64 instant_compare(Instant const *left, Instant const *right);
+
 /// Retrieves the local DateTime
 /// @return Local DateTime
+///
+/// @note Uses the reentrant variant of localtime
 SOLARIS_API Time time_now(void);
 
 /// Retrieves the corresponding UTC DateTime
 /// @return UTC DateTime
 SOLARIS_API Time time_utc(void);
 
+/// Retrieves the offset of the local time zone to UTC in seconds
+/// @return Offset in seconds, positive east of Greenwich
+///
+/// @note The offset is cached for the current quarter hour, on which all time
+///       zone transitions fall. Conversions that depend on the local time zone
+///       stay lock-free and only read the clock. Use `time_zone_refresh` after
+///       the time zone itself changes.
+SOLARIS_API s64 time_utc_offset(void);
+
+/// Reads the offset of the local time zone to UTC again and caches it
+/// @return Offset in seconds, positive east of Greenwich
+SOLARIS_API s64 time_zone_refresh(void);
+
 /// Retrieves the UTC DateTime which is relative to the specified local time
 /// @param local_time The local time
 /// @return UTC DateTime relative to the specified local time
 ///
 /// @note There is no guarantee that the relative UTC DateTime is fully correct.
-///       Internally, the current UTC offset is used, so there can be differences
+///       Internally, the cached UTC offset is used, so there can be differences
 ///       when there would be a time shift.
 SOLARIS_API Time time_utc_local(Time const *local_time);
 
+/// Retrieves the UTC DateTime of the local time with the explicit offset
+/// @param local_time The local time
+/// @param utc_offset The offset of the local time to UTC in seconds, positive east of Greenwich
+/// @return UTC DateTime
+SOLARIS_API Time time_utc_local_offset(Time const *local_time, s64 utc_offset);
+
 /// Calculates the difference of the two DateTimes in seconds
 /// @param a First DateTime
 /// @param b Second DateTime
 /// @return Difference in seconds (b - a)
+///
+/// @note Both DateTimes are taken from the same time scale, time shifts in between are not considered
 SOLARIS_API s64 time_difference(Time const *a, Time const *b);
 
 /// Calculates the julian day number for the given date
@@ -89,6 +174,11 @@ SOLARIS_API f64 time_mjdn(Time const *date);
 /// @return The julian centuries since J2000
 SOLARIS_API f64 time_jc(Time const *date, b8 floor);
 
+/// Calculates the julian centuries since J2000 for the specified julian day number
+/// @param jdn The julian day number
+/// @return The julian centuries since J2000
+SOLARIS_API f64 time_jc_jdn(f64 jdn);
+
 /// Returns the bessel epoch for the given date
 /// @param date Date for the calculation
 /// @return Bessel epoch
@@ -99,11 +189,92 @@ SOLARIS_API f64 time_be(Time const *date);
 /// @return Sidereal time in math_degrees
 SOLARIS_API f64 time_gmst(Time const *utc);
 
-/// Computes the unix timestamp for the date
+/// Calculates the greenwich mean sidereal time in math_degrees
+/// @param mjdn The mean julian day number of the utc time
+/// @return Sidereal time in math_degrees
+SOLARIS_API f64 time_gmst_mjdn(f64 mjdn);
+
+/// Size of the buffer of an ISO 8601 string including the terminator, which
+/// also fits the expanded representation of years beyond 0000 to 9999
+#define TIME_ISO8601_SIZE 32
+
+/// Converts the julian day number to a date
+/// @param jdn The julian day number
+/// @return The date, rounded to milliseconds
+///
+/// @note Inverse of `time_jdn`, with the same switch between the julian and gregorian calendar
+SOLARIS_API Time time_from_jdn(f64 jdn);
+
+/// Converts the mean julian day number to a date
+/// @param mjdn The mean julian day number
+/// @return The date, rounded to milliseconds
+SOLARIS_API Time time_from_mjdn(f64 mjdn);
+
+/// Converts arrays of julian day numbers to dates
+/// @param jdn The julian day numbers
+/// @param dates The resulting dates, rounded to milliseconds
+/// @param count The number of dates
+///
+/// @note The calendar date is reused while consecutive samples fall on the same day
+SOLARIS_API void time_from_jdn_batch(f64 const *jdn, Time *dates, usize count);
+
+/// Formats the date as ISO 8601 string (YYYY-MM-DDTHH:MM:SS.sss)
 /// @param date The date
+/// @param buffer The buffer of at least TIME_ISO8601_SIZE characters
+/// @return The length of the string without the terminator
+SOLARIS_API usize time_iso8601(Time const *date, char *buffer);
+
+/// Formats arrays of julian day numbers as ISO 8601 strings
+/// @param jdn The julian day numbers
+/// @param strings The resulting column of strings, where the string i starts at `strings + i * TIME_ISO8601_SIZE`
+/// @param count The number of strings
+SOLARIS_API void time_iso8601_batch(f64 const *jdn, char *strings, usize count);
+
+/// Calculates the julian day numbers and julian centuries of arrays of instants
+/// @param instants The instants
+/// @param jdn The resulting julian day numbers
+/// @param jc The resulting julian centuries since J2000, may be nil
+/// @param count The number of instants
+SOLARIS_API void instant_jdn_batch(Instant const *instants, f64 *jdn, f64 *jc, usize count);
+
+/// Calculates the greenwich mean sidereal time in degrees of arrays of mean julian day numbers
+/// @param mjdn The mean julian day numbers of the utc times
+/// @param gmst The resulting sidereal times in degrees
+/// @param count The number of times
+///
+/// @note Uses the continuous form of the IAU 1982 expression, which agrees with
+///       `time_gmst_mjdn` within 1e-6 degrees. The best instruction set is selected at runtime.
+SOLARIS_API void time_gmst_mjdn_batch(f64 const *mjdn, f64 *gmst, usize count);
+
+/// Calculates the greenwich mean sidereal time in degrees along a uniform timeline
+/// @param start_mjdn The mean julian day number of the first utc time
+/// @param step The distance between two steps in days
+/// @param steps The number of steps
+/// @param gmst The resulting sidereal times in degrees
+///
+/// @note The linear part advances by a fixed rotation per step, only the small
+///       secular correction is evaluated for every step
+SOLARIS_API void time_gmst_timeline(f64 start_mjdn, f64 step, usize steps, f64 *gmst);
+
+/// Computes the unix timestamp for the date
+/// @param date The date in local time
 /// @return Unix timestamp
+///
+/// @note Uses the cached UTC offset of `time_utc_offset`
 SOLARIS_API time_t time_unix(Time const *date);
 
+/// Computes the unix timestamp for the date with the explicit offset
+/// @param date The date
+/// @param utc_offset The offset of the date to UTC in seconds, positive east of Greenwich
+/// @return Unix timestamp
+SOLARIS_API s64 time_unix_offset(Time const *date, s64 utc_offset);
+
+/// Converts the unix timestamp to a DateTime with the explicit offset
+/// @param timestamp The unix timestamp
+/// @param utc_offset The offset of the resulting DateTime to UTC in seconds, positive east of Greenwich
+/// @return The DateTime
+SOLARIS_API Time time_from_unix(s64 timestamp, s64 utc_offset);
+
 /// Checks if the specified date is valid
 /// @param date The date
 /// @return Boolean that states whether the date is valid
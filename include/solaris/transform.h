@@ -0,0 +1,96 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Elias Engelbert Plank
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SOLARIS_TRANSFORM_H
+#define SOLARIS_TRANSFORM_H
+
+#include <solaris/linear.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Default quantum of the epochs of a transform cache, one minute in days
+#define TRANSFORM_CACHE_QUANTUM (1.0 / 1440.0)
+
+enum {
+    TRANSFORM_CACHE_SLOTS = 8,
+};
+
+/// Cached transformation matrix of an epoch
+typedef struct TransformCacheEntry {
+    f64 epoch;
+    Matrix3x3 matrix;
+    b8 valid;
+} TransformCacheEntry;
+
+/// Caller-owned cache of the precession and frame matrices by epoch
+/// @note Epochs are rounded to multiples of the quantum, so all positions
+///       within one quantum share the same matrices. A quantum of zero only
+///       shares matrices of exactly equal epochs. The slots are direct mapped,
+///       a few recent epochs stay cached at the same time.
+typedef struct TransformCache {
+    f64 quantum;
+    TransformCacheEntry objects[TRANSFORM_CACHE_SLOTS];
+    TransformCacheEntry planets[TRANSFORM_CACHE_SLOTS];
+    usize hits;
+    usize misses;
+} TransformCache;
+
+/// Creates an empty transform cache
+/// @param quantum The quantum of the epochs in days, TRANSFORM_CACHE_QUANTUM for one minute
+/// @return The transform cache
+SOLARIS_API TransformCache transform_cache_make(f64 quantum);
+
+/// Retrieves the precession from the catalog epoch of fixed objects to the equinox of date
+/// @param cache The transform cache
+/// @param jdn Julian day number of the equinox of date
+/// @return The cached transformation matrix
+SOLARIS_API Matrix3x3 const *transform_cache_object(TransformCache *cache, f64 jdn);
+
+/// Retrieves the fused transformation from the J2000 ecliptic to the equator of date
+/// @param cache The transform cache
+/// @param jdn Julian day number of the equinox of date
+/// @return The cached transformation matrix, precession times ecliptic to equatorial frame
+SOLARIS_API Matrix3x3 const *transform_cache_planet(TransformCache *cache, f64 jdn);
+
+/// Creates the time context of an instant
+/// @param jdn Julian day number of the (local) date and time
+/// @param utc_offset The offset of the local time to UTC in seconds, positive east of Greenwich
+/// @return The time context
+///
+/// @note The greenwich mean sidereal time is derived from UTC, hence observing
+///       with the context requires an observer context with the same offset.
+SOLARIS_API TimeContext time_context_make(f64 jdn, s64 utc_offset);
+
+/// Creates the time context of an instant with the UTC offset of the observer
+/// @param date The (local) date and time
+/// @param observer The observer context that provides the UTC offset
+/// @return The time context
+SOLARIS_API TimeContext time_context_observer(Time const *date, ObserverContext const *observer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif// SOLARIS_TRANSFORM_H
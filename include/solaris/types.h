@@ -62,7 +62,7 @@ typedef u8 b8;
 
 #define nil NULL
 
-#define ARRAY_SIZE_IMPL(arr) sizeof(arr) / sizeof(arr[0])
+#define ARRAY_SIZE_IMPL(arr) (sizeof(arr) / sizeof(arr[0]))
 #define ARRAY_SIZE(arr) ARRAY_SIZE_IMPL(arr)
 
 #endif// SOLARIS_TYPES_H
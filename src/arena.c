@@ -23,77 +23,440 @@
 
 #include <stdlib.h>
 
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sys/mman.h>
+#endif
+
+#if !defined(_MSC_VER) || defined(__clang__)
+#include <stdatomic.h>
+#endif
+
 #include <solaris/arena.h>
 
 enum {
     BLOCK_SIZE = 4 * 1024,
+    COMMIT_SIZE = 64 * 1024,
+    HUGE_PAGE_SIZE = 2 * 1024 * 1024,
+    CONCURRENT_CHUNK_SIZE = 256 * 1024,
 };
 
+#ifdef _WIN32
+typedef CRITICAL_SECTION ConcurrentMutex;
+#else
+typedef pthread_mutex_t ConcurrentMutex;
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+typedef LONG64 volatile ConcurrentOffset;
+typedef struct ConcurrentRegion *volatile ConcurrentRegionPointer;
+#else
+typedef _Atomic usize ConcurrentOffset;
+typedef struct ConcurrentRegion *_Atomic ConcurrentRegionPointer;
+#endif
+
+/// Chunk of a concurrent arena, threads bump the used offset atomically
+typedef struct ConcurrentRegion {
+    u8 *base;
+    usize size;
+    ConcurrentOffset used;
+} ConcurrentRegion;
+
+struct ConcurrentArenaState {
+    ConcurrentRegionPointer current;
+    usize alignment;
+
+    // The backing arena, guarded by the mutex
+    ConcurrentMutex mutex;
+    MemoryArena backing;
+};
+
+#ifdef _WIN32
+static void concurrent_mutex_init(ConcurrentMutex *const mutex) {
+    InitializeCriticalSection(mutex);
+}
+
+static void concurrent_mutex_destroy(ConcurrentMutex *const mutex) {
+    DeleteCriticalSection(mutex);
+}
+
+static void concurrent_mutex_lock(ConcurrentMutex *const mutex) {
+    EnterCriticalSection(mutex);
+}
+
+static void concurrent_mutex_unlock(ConcurrentMutex *const mutex) {
+    LeaveCriticalSection(mutex);
+}
+#else
+static void concurrent_mutex_init(ConcurrentMutex *const mutex) {
+    pthread_mutex_init(mutex, nil);
+}
+
+static void concurrent_mutex_destroy(ConcurrentMutex *const mutex) {
+    pthread_mutex_destroy(mutex);
+}
+
+static void concurrent_mutex_lock(ConcurrentMutex *const mutex) {
+    pthread_mutex_lock(mutex);
+}
+
+static void concurrent_mutex_unlock(ConcurrentMutex *const mutex) {
+    pthread_mutex_unlock(mutex);
+}
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+static void concurrent_offset_init(ConcurrentOffset *const offset, usize const value) {
+    *offset = (LONG64) value;
+}
+
+static usize concurrent_offset_add(ConcurrentOffset *const offset, usize const value) {
+    return (usize) InterlockedExchangeAdd64(offset, (LONG64) value);
+}
+
+static ConcurrentRegion *concurrent_region_load(ConcurrentRegionPointer *const pointer) {
+    return InterlockedCompareExchangePointer((PVOID volatile *) pointer, nil, nil);
+}
+
+static void concurrent_region_store(ConcurrentRegionPointer *const pointer, ConcurrentRegion *const region) {
+    InterlockedExchangePointer((PVOID volatile *) pointer, region);
+}
+#else
+static void concurrent_offset_init(ConcurrentOffset *const offset, usize const value) {
+    atomic_init(offset, value);
+}
+
+static usize concurrent_offset_add(ConcurrentOffset *const offset, usize const value) {
+    return atomic_fetch_add_explicit(offset, value, memory_order_relaxed);
+}
+
+static ConcurrentRegion *concurrent_region_load(ConcurrentRegionPointer *const pointer) {
+    return atomic_load_explicit(pointer, memory_order_acquire);
+}
+
+static void concurrent_region_store(ConcurrentRegionPointer *const pointer, ConcurrentRegion *const region) {
+    atomic_store_explicit(pointer, region, memory_order_release);
+}
+#endif
+
+/// Default address space of a virtual block, smaller on 32-bit targets
+static usize const VIRTUAL_BLOCK_SIZE = sizeof(void *) >= 8 ? (usize) 1 << 30 : (usize) 64 << 20;
+
+/// Reserves address space without committing memory
+static void *memory_virtual_reserve(usize const size, b8 const huge_pages) {
+#ifdef _WIN32
+    // Large pages need the lock memory privilege, so they are not requested
+    (void) huge_pages;
+    return VirtualAlloc(nil, size, MEM_RESERVE, PAGE_NOACCESS);
+#else
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+    flags |= MAP_NORESERVE;
+#endif
+    void *const address = mmap(nil, size, PROT_NONE, flags, -1, 0);
+    if (address == MAP_FAILED) {
+        return nil;
+    }
+#ifdef MADV_HUGEPAGE
+    if (huge_pages) {
+        madvise(address, size, MADV_HUGEPAGE);
+    }
+#else
+    (void) huge_pages;
+#endif
+    return address;
+#endif
+}
+
+/// Commits the reserved pages of the range
+static b8 memory_virtual_commit(void *const address, usize const size) {
+#ifdef _WIN32
+    return VirtualAlloc(address, size, MEM_COMMIT, PAGE_READWRITE) != nil;
+#else
+    return mprotect(address, size, PROT_READ | PROT_WRITE) == 0;
+#endif
+}
+
+/// Releases the reserved address space
+static void memory_virtual_release(void *const address, usize const size) {
+#ifdef _WIN32
+    (void) size;
+    VirtualFree(address, 0, MEM_RELEASE);
+#else
+    munmap(address, size);
+#endif
+}
+
 /// Align the specified size according to arena alignment
 static usize memory_arena_alignment_size(MemoryArena const *const arena, usize size) {
     usize const alignment = (usize) arena->alignment;
     return (size + alignment - 1) & ~(alignment - 1);
 }
 
-/// Align the used offset according to arena alignment
-static usize memory_arena_alignment_offset(MemoryArena const *const arena) {
-    return memory_arena_alignment_size(arena, arena->current->used);
+/// Align the address of the used offset, so that the address is aligned and not only the offset
+static usize memory_arena_alignment_offset(MemoryBlock const *const block, usize const alignment) {
+    uintptr_t const address = (uintptr_t) (block->base + block->used);
+    uintptr_t const aligned = (address + alignment - 1) & ~((uintptr_t) alignment - 1);
+    return block->used + (usize) (aligned - address);
+}
+
+/// Align the base of the block that starts at the address behind its header
+static u8 *memory_arena_block_base(MemoryArena const *const arena, void *const block) {
+    uintptr_t const address = (uintptr_t) block + sizeof(MemoryBlock);
+    uintptr_t const alignment = (uintptr_t) arena->alignment;
+    return (u8 *) ((address + alignment - 1) & ~(alignment - 1));
+}
+
+/// Size of the block header including the padding before the base
+static usize memory_arena_block_header(MemoryBlock const *const block) {
+    return (usize) (block->base - (u8 const *) block);
+}
+
+/// Round the size up to the commit granularity of the arena
+static usize memory_arena_commit_size(MemoryArena const *const arena, usize const size) {
+    usize const granularity = arena->huge_pages ? HUGE_PAGE_SIZE : COMMIT_SIZE;
+    return (size + granularity - 1) / granularity * granularity;
 }
 
-/// Creates a new memory block
+/// Commits the pages of the virtual block, so that the specified amount of bytes is usable
+static b8 memory_arena_block_commit(MemoryArena *const arena, MemoryBlock *const block, usize const size) {
+    if (size <= block->committed) {
+        return true;
+    }
+
+    // Commit in growing steps, so that a growing buffer does not commit page by page
+    usize const header = memory_arena_block_header(block);
+    usize const desired = size > 2 * block->committed ? size : 2 * block->committed;
+    usize const end = memory_arena_commit_size(arena, header + desired);
+    usize const limit = header + block->size;
+    usize const committed_end = end < limit ? end : limit;
+
+    // Committed ranges always end at the commit granularity, so the next range starts at a page boundary
+    usize const start = header + block->committed;
+    if (!memory_virtual_commit((u8 *) block + start, committed_end - start)) {
+        return false;
+    }
+    usize const committed = committed_end - header;
+    arena->total_memory += committed - block->committed;
+    block->committed = committed;
+    return true;
+}
+
+static void *concurrent_arena_state_alloc(ConcurrentArenaState *state, usize size);
+
+/// Creates a new memory block, or returns nil if the memory cannot be reserved
 static MemoryBlock *memory_arena_block_new(MemoryArena *const arena, usize const requested_size) {
     // At this point, the requested size is already aligned
-    usize const actual_size = requested_size > BLOCK_SIZE ? requested_size : BLOCK_SIZE;
+    usize const actual_size = requested_size > arena->next_block_size ? requested_size : arena->next_block_size;
+
+    // The header is followed by the padding that aligns the base
+    usize const header = sizeof(MemoryBlock) + (usize) arena->alignment - 1;
+    MemoryBlock *block;
+    if (arena->backend == MEMORY_BACKEND_VIRTUAL) {
+        usize const reserved = memory_arena_commit_size(arena, header + actual_size);
+        block = memory_virtual_reserve(reserved, arena->huge_pages);
+        if (block == nil) {
+            return nil;
+        }
+        u8 *const base = memory_arena_block_base(arena, block);
+        usize const initial = memory_arena_commit_size(arena, (usize) (base - (u8 *) block) + 1);
+        if (!memory_virtual_commit(block, initial)) {
+            memory_virtual_release(block, reserved);
+            return nil;
+        }
+        block->base = base;
+        block->size = reserved - memory_arena_block_header(block);
+        block->committed = initial - memory_arena_block_header(block);
+    } else {
+        block = arena->backend == MEMORY_BACKEND_CONCURRENT
+                        ? concurrent_arena_state_alloc(arena->shared, header + actual_size)
+                        : arena->reserve(header + actual_size);
+        if (block == nil) {
+            return nil;
+        }
+        block->base = memory_arena_block_base(arena, block);
+        block->size = actual_size;
+        block->committed = actual_size;
+    }
 
-    MemoryBlock *block = arena->reserve(sizeof(MemoryBlock) + actual_size);
-    block->base = (u8 *) block + sizeof(MemoryBlock);
-    block->size = actual_size;
+    if (arena->growth_factor > 1.0 && actual_size == arena->next_block_size) {
+        arena->next_block_size = (usize) ((f64) arena->next_block_size * arena->growth_factor);
+    }
     block->used = 0;
     block->before = nil;
     block->id = arena->blocks++;
-    arena->total_memory += BLOCK_SIZE;
+    arena->total_memory += block->committed;
     return block;
 }
 
-/// Creates a new memory arena
-MemoryArena memory_arena_make(MemoryArenaSpecification const *const spec) {
+/// Releases the memory block
+static void memory_arena_block_release(MemoryArena *const arena, MemoryBlock *const block) {
+    arena->blocks--;
+    arena->total_memory -= block->committed;
+    // Concurrent blocks are released together with the concurrent arena
+    if (arena->backend == MEMORY_BACKEND_VIRTUAL) {
+        memory_virtual_release(block, memory_arena_block_header(block) + block->size);
+    } else if (arena->backend == MEMORY_BACKEND_HEAP) {
+        arena->release(block);
+    }
+}
+
+/// Releases all memory blocks of the list
+static void memory_arena_block_release_all(MemoryArena *const arena, MemoryBlock *it) {
+    while (it != nil) {
+        MemoryBlock *before = it->before;
+        memory_arena_block_release(arena, it);
+        it = before;
+    }
+}
+
+/// Takes a free memory block with enough space, or creates a new memory block
+static MemoryBlock *memory_arena_block_acquire(MemoryArena *const arena, usize const requested_size) {
+    for (MemoryBlock **it = &arena->free; *it != nil; it = &(*it)->before) {
+        MemoryBlock *const block = *it;
+        if (block->size >= requested_size) {
+            *it = block->before;
+            block->used = 0;
+            block->before = nil;
+            return block;
+        }
+    }
+    return memory_arena_block_new(arena, requested_size);
+}
+
+/// Creates a new memory arena, whose concurrent blocks are taken from the shared state
+static MemoryArena memory_arena_make_shared(MemoryArenaSpecification const *const spec,
+                                           ConcurrentArenaState *const shared) {
     MemoryArena result;
     result.alignment = spec->alignment;
     result.reserve = spec->reserve;
     result.release = spec->release;
+    result.backend = spec->backend;
+    result.block_size = spec->block_size;
+    if (result.block_size == 0) {
+        result.block_size = spec->backend == MEMORY_BACKEND_VIRTUAL ? VIRTUAL_BLOCK_SIZE : BLOCK_SIZE;
+    }
+    result.next_block_size = result.block_size;
+    result.growth_factor = spec->growth_factor;
+    result.huge_pages = spec->huge_pages;
+    result.shared = shared;
     result.blocks = 0;
     result.total_memory = 0;
+    result.free = nil;
     result.current = memory_arena_block_new(&result, 0);
     return result;
 }
 
+/// Creates a new memory arena
+MemoryArena memory_arena_make(MemoryArenaSpecification const *const spec) {
+    return memory_arena_make_shared(spec, nil);
+}
+
 /// Creates an identity memory arena
 MemoryArena memory_arena_identity(MemoryAlignment const alignment) {
     MemoryArenaSpecification spec;
     spec.alignment = alignment;
     spec.reserve = malloc;
     spec.release = free;
+    spec.backend = MEMORY_BACKEND_HEAP;
+    spec.block_size = BLOCK_SIZE;
+    spec.growth_factor = 1.0;
+    spec.huge_pages = false;
+    return memory_arena_make(&spec);
+}
+
+/// Creates a virtual memory arena
+MemoryArena memory_arena_virtual(MemoryAlignment const alignment, usize const reserve_size) {
+    MemoryArenaSpecification spec;
+    spec.alignment = alignment;
+    spec.reserve = nil;
+    spec.release = nil;
+    spec.backend = MEMORY_BACKEND_VIRTUAL;
+    spec.block_size = reserve_size;
+    spec.growth_factor = 1.0;
+    spec.huge_pages = false;
     return memory_arena_make(&spec);
 }
 
 /// Clears the memory arena by freeing all blocks
 void memory_arena_clear(MemoryArena *const arena) {
-    for (MemoryBlock *it = arena->current; it != nil; it = it->before) {
-        arena->release(it);
-    }
+    memory_arena_block_release_all(arena, arena->current);
+    memory_arena_block_release_all(arena, arena->free);
+    arena->free = nil;
     arena->blocks = 0;
     arena->total_memory = 0;
+    arena->next_block_size = arena->block_size;
     arena->current = memory_arena_block_new(arena, 0);
 }
 
-/// Destroys the specified memory arena
-void memory_arena_destroy(MemoryArena *const arena) {
-    while (arena->current != nil) {
+/// Resets the memory arena, keeping only its largest block
+void memory_arena_reset(MemoryArena *const arena) {
+    // An arena whose first block could not be created may still hold rewound blocks
+    if (arena->current == nil) {
+        arena->current = arena->free;
+        arena->free = nil;
+        if (arena->current == nil) {
+            return;
+        }
+    }
+
+    // Collect all blocks in one list and pick the largest one
+    MemoryBlock *largest = arena->current;
+    MemoryBlock *it = arena->current;
+    while (it->before != nil) {
+        it = it->before;
+        largest = it->size > largest->size ? it : largest;
+    }
+    it->before = arena->free;
+    for (it = arena->free; it != nil; it = it->before) {
+        largest = it->size > largest->size ? it : largest;
+    }
+
+    it = arena->current;
+    while (it != nil) {
+        MemoryBlock *before = it->before;
+        if (it != largest) {
+            memory_arena_block_release(arena, it);
+        }
+        it = before;
+    }
+    largest->used = 0;
+    largest->before = nil;
+    arena->current = largest;
+    arena->free = nil;
+}
+
+/// Retrieves the save-point of the current position of the arena
+MemoryArenaMark memory_arena_mark(MemoryArena const *const arena) {
+    MemoryArenaMark mark;
+    mark.block = arena->current;
+    mark.used = arena->current != nil ? arena->current->used : 0;
+    return mark;
+}
+
+/// Rewinds the memory arena to the save-point, releasing all allocations after it
+void memory_arena_rewind(MemoryArena *const arena, MemoryArenaMark const mark) {
+    // Blocks after the save-point move to the free list
+    while (arena->current != mark.block) {
         MemoryBlock *before = arena->current->before;
-        // We must release the memory block itself as it is the base of the allocation
-        arena->release(arena->current);
+        arena->current->before = arena->free;
+        arena->free = arena->current;
         arena->current = before;
     }
+    if (arena->current != nil) {
+        arena->current->used = mark.used;
+    }
+}
+
+/// Destroys the specified memory arena
+void memory_arena_destroy(MemoryArena *const arena) {
+    // We must release the memory block itself as it is the base of the allocation
+    memory_arena_block_release_all(arena, arena->current);
+    memory_arena_block_release_all(arena, arena->free);
+    arena->free = nil;
     arena->reserve = nil;
     arena->release = nil;
     arena->current = nil;
@@ -103,18 +466,155 @@ void memory_arena_destroy(MemoryArena *const arena) {
 
 /// Allocate a block of memory in the specified arena
 void *memory_arena_alloc(MemoryArena *const arena, usize const size) {
+    return memory_arena_alloc_aligned(arena, size, arena->alignment);
+}
+
+/// Allocate a block of memory in the specified arena with a specific alignment
+void *memory_arena_alloc_aligned(MemoryArena *const arena, usize const size, MemoryAlignment const alignment) {
     usize const aligned_size = memory_arena_alignment_size(arena, size);
+    usize const address_alignment = alignment > arena->alignment ? (usize) alignment : (usize) arena->alignment;
 
-    if (arena->current->used + aligned_size > arena->current->size) {
-        // Not enough space → add new block and prepend to list
-        MemoryBlock *new_block = memory_arena_block_new(arena, aligned_size);
+    usize offset = arena->current != nil ? memory_arena_alignment_offset(arena->current, address_alignment) : 0;
+    if (arena->current == nil || offset + aligned_size > arena->current->size) {
+        // Not enough space → add free or new block and prepend to list, the base
+        // of the block is aligned to the arena, so stricter alignments need padding
+        usize const padding = address_alignment - (usize) arena->alignment;
+        MemoryBlock *new_block = memory_arena_block_acquire(arena, aligned_size + padding);
+        if (new_block == nil) {
+            return nil;
+        }
         new_block->before = arena->current;
         arena->current = new_block;
+        offset = memory_arena_alignment_offset(arena->current, address_alignment);
     }
 
-    usize const offset = memory_arena_alignment_offset(arena);
+    if (!memory_arena_block_commit(arena, arena->current, offset + aligned_size)) {
+        return nil;
+    }
     void *result = arena->current->base + offset;
     arena->current->used = offset + aligned_size;
 
     return result;
 }
+
+/// Allocates a new region for the concurrent arena, the mutex must be locked
+static ConcurrentRegion *concurrent_arena_region_new(ConcurrentArenaState *const state, usize const size) {
+    MemoryArenaMark const mark = memory_arena_mark(&state->backing);
+    ConcurrentRegion *const region = memory_arena_alloc(&state->backing, sizeof(ConcurrentRegion));
+    if (region == nil) {
+        return nil;
+    }
+    region->base = memory_arena_alloc(&state->backing, size);
+    if (region->base == nil) {
+        memory_arena_rewind(&state->backing, mark);
+        return nil;
+    }
+    region->size = size;
+    concurrent_offset_init(&region->used, 0);
+    return region;
+}
+
+/// Allocate a block of memory in the shared state of a concurrent arena
+static void *concurrent_arena_state_alloc(ConcurrentArenaState *const state, usize const size) {
+    usize const aligned_size = (size + state->alignment - 1) & ~(state->alignment - 1);
+
+    // Large allocations would waste most of a region, they are taken from the backing arena directly
+    if (aligned_size > CONCURRENT_CHUNK_SIZE / 4) {
+        concurrent_mutex_lock(&state->mutex);
+        void *const result = memory_arena_alloc(&state->backing, aligned_size);
+        concurrent_mutex_unlock(&state->mutex);
+        return result;
+    }
+
+    for (;;) {
+        ConcurrentRegion *const region = concurrent_region_load(&state->current);
+        usize const offset = concurrent_offset_add(&region->used, aligned_size);
+        if (offset + aligned_size <= region->size) {
+            return region->base + offset;
+        }
+
+        // The region is exhausted, only the first thread that notices replaces it
+        concurrent_mutex_lock(&state->mutex);
+        if (concurrent_region_load(&state->current) == region) {
+            ConcurrentRegion *const next = concurrent_arena_region_new(state, CONCURRENT_CHUNK_SIZE);
+            if (next == nil) {
+                concurrent_mutex_unlock(&state->mutex);
+                return nil;
+            }
+            concurrent_region_store(&state->current, next);
+        }
+        concurrent_mutex_unlock(&state->mutex);
+    }
+}
+
+/// Creates a new concurrent memory arena
+ConcurrentArena concurrent_arena_make(MemoryArenaSpecification const *const spec) {
+    ConcurrentArena result;
+    result.state = nil;
+    ConcurrentArenaState *const state = malloc(sizeof(ConcurrentArenaState));
+    if (state == nil) {
+        return result;
+    }
+    state->backing = memory_arena_make(spec);
+
+    // Blocks of views are carved from the regions, so their headers need pointer alignment
+    state->alignment = (usize) spec->alignment > sizeof(void *) ? (usize) spec->alignment : sizeof(void *);
+    ConcurrentRegion *const region = concurrent_arena_region_new(state, CONCURRENT_CHUNK_SIZE);
+    if (region == nil) {
+        memory_arena_destroy(&state->backing);
+        free(state);
+        return result;
+    }
+    concurrent_mutex_init(&state->mutex);
+    concurrent_region_store(&state->current, region);
+
+    result.state = state;
+    return result;
+}
+
+/// Creates a concurrent identity memory arena
+ConcurrentArena concurrent_arena_identity(MemoryAlignment const alignment) {
+    MemoryArenaSpecification spec;
+    spec.alignment = alignment;
+    spec.reserve = malloc;
+    spec.release = free;
+    spec.backend = MEMORY_BACKEND_HEAP;
+    spec.block_size = 4 * CONCURRENT_CHUNK_SIZE;
+    spec.growth_factor = 1.0;
+    spec.huge_pages = false;
+    return concurrent_arena_make(&spec);
+}
+
+/// Allocate a block of memory in the concurrent arena, safe to call from any thread
+void *concurrent_arena_alloc(ConcurrentArena *const arena, usize const size) {
+    return concurrent_arena_state_alloc(arena->state, size);
+}
+
+/// Creates a memory arena for one thread, whose blocks are taken from the concurrent arena
+MemoryArena concurrent_arena_view(ConcurrentArena *const arena, MemoryAlignment const alignment) {
+    MemoryArenaSpecification spec;
+    spec.alignment = alignment;
+    spec.reserve = nil;
+    spec.release = nil;
+    spec.backend = MEMORY_BACKEND_CONCURRENT;
+    spec.block_size = BLOCK_SIZE;
+    spec.growth_factor = 2.0;
+    spec.huge_pages = false;
+    return memory_arena_make_shared(&spec, arena->state);
+}
+
+/// Retrieves the amount of memory that the concurrent arena reserved
+usize concurrent_arena_total_memory(ConcurrentArena *const arena) {
+    concurrent_mutex_lock(&arena->state->mutex);
+    usize const result = arena->state->backing.total_memory;
+    concurrent_mutex_unlock(&arena->state->mutex);
+    return result;
+}
+
+/// Destroys the concurrent arena and releases the memory of all views at once
+void concurrent_arena_destroy(ConcurrentArena *const arena) {
+    memory_arena_destroy(&arena->state->backing);
+    concurrent_mutex_destroy(&arena->state->mutex);
+    free(arena->state);
+    arena->state = nil;
+}
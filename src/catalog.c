@@ -21,17 +21,134 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sched.h>
+#endif
+
+#if !defined(_MSC_VER) || defined(__clang__)
+#include <stdatomic.h>
+#endif
+
 #include <solaris/catalog.h>
 
 #include "gen/objects.h"
 #include "gen/planets.h"
 
+static f64 generated_right_ascensions[ARRAY_SIZE(generated_objects)];
+static f64 generated_declinations[ARRAY_SIZE(generated_objects)];
+static f64 generated_magnitudes[ARRAY_SIZE(generated_objects)];
+static f64 generated_dimensions[ARRAY_SIZE(generated_objects)];
+static Classification generated_classifications[ARRAY_SIZE(generated_objects)];
+static Constellation generated_constellations[ARRAY_SIZE(generated_objects)];
+static Designation generated_designations[ARRAY_SIZE(generated_objects)];
+
+enum {
+    GENERATED_COLUMNS_EMPTY,
+    GENERATED_COLUMNS_FILLING,
+    GENERATED_COLUMNS_FILLED,
+};
+
+#if defined(_MSC_VER) && !defined(__clang__)
+static LONG volatile generated_columns_state = GENERATED_COLUMNS_EMPTY;
+
+static s32 generated_columns_load(void) {
+    return InterlockedCompareExchange(&generated_columns_state, 0, 0);
+}
+
+static b8 generated_columns_claim(void) {
+    return InterlockedCompareExchange(&generated_columns_state, GENERATED_COLUMNS_FILLING, GENERATED_COLUMNS_EMPTY) ==
+           GENERATED_COLUMNS_EMPTY;
+}
+
+static void generated_columns_publish(void) {
+    InterlockedExchange(&generated_columns_state, GENERATED_COLUMNS_FILLED);
+}
+#else
+static _Atomic s32 generated_columns_state = GENERATED_COLUMNS_EMPTY;
+
+static s32 generated_columns_load(void) {
+    return atomic_load_explicit(&generated_columns_state, memory_order_acquire);
+}
+
+static b8 generated_columns_claim(void) {
+    s32 expected = GENERATED_COLUMNS_EMPTY;
+    return atomic_compare_exchange_strong_explicit(&generated_columns_state, &expected, GENERATED_COLUMNS_FILLING,
+                                                   memory_order_acquire, memory_order_acquire);
+}
+
+static void generated_columns_publish(void) {
+    atomic_store_explicit(&generated_columns_state, GENERATED_COLUMNS_FILLED, memory_order_release);
+}
+#endif
+
+/// Yields the processor until the columns are published by the filling thread
+static void generated_columns_wait(void) {
+    while (generated_columns_load() != GENERATED_COLUMNS_FILLED) {
+#ifdef _WIN32
+        SwitchToThread();
+#else
+        sched_yield();
+#endif
+    }
+}
+
+/// Fills the columns with the fields of the objects
+static void catalog_columns_fill(ObjectColumns *const columns, Object const *const objects, usize const count) {
+    for (usize i = 0; i < count; ++i) {
+        columns->right_ascensions[i] = objects[i].position.right_ascension;
+        columns->declinations[i] = objects[i].position.declination;
+        columns->magnitudes[i] = objects[i].magnitude;
+        columns->dimensions[i] = objects[i].dimension;
+        columns->classifications[i] = objects[i].classification;
+        columns->constellations[i] = objects[i].constellation;
+        columns->designations[i] = objects[i].designation;
+    }
+    columns->count = count;
+}
+
 /// Acquire the builtin catalog
 Catalog catalog_acquire(void) {
+    ObjectColumns columns = { .right_ascensions = generated_right_ascensions,
+                              .declinations = generated_declinations,
+                              .magnitudes = generated_magnitudes,
+                              .dimensions = generated_dimensions,
+                              .classifications = generated_classifications,
+                              .constellations = generated_constellations,
+                              .designations = generated_designations,
+                              .count = ARRAY_SIZE(generated_objects) };
+
+    // The first caller fills the columns, concurrent callers wait until they are published
+    if (generated_columns_load() != GENERATED_COLUMNS_FILLED) {
+        if (generated_columns_claim()) {
+            catalog_columns_fill(&columns, generated_objects, ARRAY_SIZE(generated_objects));
+            generated_columns_publish();
+        } else {
+            generated_columns_wait();
+        }
+    }
+
     return (Catalog) { .planets = generated_planets,
                        .objects = generated_objects,
                        .planet_count = ARRAY_SIZE(generated_planets),
-                       .object_count = ARRAY_SIZE(generated_objects) };
+                       .object_count = ARRAY_SIZE(generated_objects),
+                       .columns = columns };
+}
+
+/// Creates the columnar view of the catalog objects
+void catalog_columns_make(MemoryArena *arena, Catalog *const catalog) {
+    usize const count = catalog->object_count;
+    ObjectColumns *const columns = &catalog->columns;
+    columns->right_ascensions = (f64 *) memory_arena_alloc_aligned(arena, count * sizeof(f64), ALIGNMENT64);
+    columns->declinations = (f64 *) memory_arena_alloc_aligned(arena, count * sizeof(f64), ALIGNMENT64);
+    columns->magnitudes = (f64 *) memory_arena_alloc_aligned(arena, count * sizeof(f64), ALIGNMENT64);
+    columns->dimensions = (f64 *) memory_arena_alloc_aligned(arena, count * sizeof(f64), ALIGNMENT64);
+    columns->classifications = (Classification *) memory_arena_alloc(arena, count * sizeof(Classification));
+    columns->constellations = (Constellation *) memory_arena_alloc(arena, count * sizeof(Constellation));
+    columns->designations = (Designation *) memory_arena_alloc(arena, count * sizeof(Designation));
+    catalog_columns_fill(columns, catalog->objects, count);
 }
 
 /// Compute the geographic position of the specified planet according to the spec
@@ -39,36 +156,449 @@ void compute_geographic_planet(MemoryArena *arena,
                                ComputeResult *result,
                                Planet const *const planet,
                                ComputeSpecification const *const spec) {
-    result->altitudes = (f64 *) memory_arena_alloc(arena, spec->steps * sizeof(f64));
-    result->azimuths = (f64 *) memory_arena_alloc(arena, spec->steps * sizeof(f64));
-    result->count = spec->steps;
+    ObserverContext const context = observer_context_make(&spec->observer);
+    compute_geographic_planet_ctx(arena, result, planet, &context, spec);
+}
+
+/// Compute the geographic position of the specified fixed object according
+/// to the specification
+void compute_geographic_fixed(MemoryArena *arena,
+                              ComputeResult *result,
+                              Object const *const object,
+                              ComputeSpecification const *const spec) {
+    ObserverContext const context = observer_context_make(&spec->observer);
+    compute_geographic_fixed_ctx(arena, result, object, &context, spec);
+}
+
+/// Creates a compute timeline from the specification
+b8 compute_timeline_make(ComputeTimeline *const timeline, ComputeSpecification const *const spec) {
+    f64 unit_days;
+    switch (spec->unit) {
+        case UNIT_SECONDS:
+            unit_days = 1.0 / SECONDS_PER_DAY;
+            break;
+        case UNIT_MINUTES:
+            unit_days = 1.0 / 1440.0;
+            break;
+        case UNIT_HOURS:
+            unit_days = 1.0 / 24.0;
+            break;
+        case UNIT_DAYS:
+            unit_days = 1.0;
+            break;
+        case UNIT_MONTHS:
+        case UNIT_YEARS:
+        default:
+            return false;
+    }
+
+    timeline->start = time_jdn(&spec->date);
+    timeline->step = (f64) spec->step_size * unit_days;
+    timeline->steps = spec->steps;
+    return true;
+}
+
+/// Creates a compute timeline that starts at the instant
+void compute_timeline_instant(ComputeTimeline *const timeline,
+                              Instant const *const start,
+                              s64 const step,
+                              usize const steps) {
+    timeline->start = instant_jdn(start);
+    timeline->step = (f64) step / INSTANT_NANOSECONDS_PER_DAY;
+    timeline->steps = steps;
+}
+
+/// Number of steps of the timeline of all planets that are computed at once
+#define PLANET_SERIES_CHUNK 32
+
+/// Computes the equatorial positions of all builtin planets at once
+void planet_positions_all(Time const *const time, Equatorial positions[PLANET_COUNT]) {
+    Equatorial computed[ARRAY_SIZE(generated_planets)];
+    planet_positions_equatorial_jdn(generated_planets, ARRAY_SIZE(generated_planets), time_jdn(time), computed);
+
+    positions[PLANET_EARTH] = (Equatorial) { 0.0, 0.0, 0.0 };
+    for (usize i = 0; i < ARRAY_SIZE(generated_planets); ++i) {
+        positions[generated_planets[i].name] = computed[i];
+    }
+}
+
+/// Computes the equatorial positions of all builtin planets along the timeline
+void planet_positions_all_timeline(MemoryArena *arena,
+                                   PlanetSeries *const series,
+                                   ComputeTimeline const *const timeline) {
+    usize const count = ARRAY_SIZE(generated_planets);
+    series->positions = (Equatorial *) memory_arena_alloc_aligned(
+            arena, timeline->steps * PLANET_COUNT * sizeof(Equatorial), ALIGNMENT64);
+    series->steps = timeline->steps;
+
+    Equatorial computed[PLANET_SERIES_CHUNK * ARRAY_SIZE(generated_planets)];
+    for (usize first = 0; first < timeline->steps; first += PLANET_SERIES_CHUNK) {
+        usize const remaining = timeline->steps - first;
+        usize const steps = remaining < PLANET_SERIES_CHUNK ? remaining : PLANET_SERIES_CHUNK;
+        f64 const start = timeline->start + (f64) first * timeline->step;
+        planet_positions_equatorial_series(generated_planets, count, start, timeline->step, steps, computed);
 
+        for (usize step = 0; step < steps; ++step) {
+            Equatorial *const positions = series->positions + (first + step) * PLANET_COUNT;
+            positions[PLANET_EARTH] = (Equatorial) { 0.0, 0.0, 0.0 };
+            for (usize i = 0; i < count; ++i) {
+                positions[generated_planets[i].name] = computed[step * count + i];
+            }
+        }
+    }
+}
+
+/// Computes the planet positions of the steps [begin, end) of the timeline
+static void compute_planet_timeline_range(ComputeResult const *const result,
+                                          Planet const *const planet,
+                                          ObserverContext const *const context,
+                                          ComputeTimeline const *const timeline,
+                                          usize const begin,
+                                          usize const end) {
+    for (usize step = begin; step < end; ++step) {
+        f64 const jdn = timeline->start + (f64) step * timeline->step;
+        Equatorial const position_planet = planet_position_equatorial_jdn(planet, jdn);
+        Horizontal const position = observe_geographic_jdn(&position_planet, context, jdn);
+        result->altitudes[step] = position.altitude;
+        result->azimuths[step] = position.azimuth;
+    }
+}
+
+/// Computes the object positions of the steps [begin, end) of the timeline
+static void compute_fixed_timeline_range(ComputeResult const *const result,
+                                         Object const *const object,
+                                         ObserverContext const *const context,
+                                         ComputeTimeline const *const timeline,
+                                         usize const begin,
+                                         usize const end) {
+    for (usize step = begin; step < end; ++step) {
+        f64 const jdn = timeline->start + (f64) step * timeline->step;
+        Equatorial const position_object = object_position_jdn(object, jdn);
+        Horizontal const position = observe_geographic_jdn(&position_object, context, jdn);
+        result->altitudes[step] = position.altitude;
+        result->azimuths[step] = position.azimuth;
+    }
+}
+
+/// Computes the object positions of every step by walking the calendar
+static void compute_fixed_calendar(ComputeResult const *const result,
+                                   Object const *const object,
+                                   ObserverContext const *const context,
+                                   ComputeSpecification const *const spec) {
     Time it = spec->date;
     for (usize step = 0; step < spec->steps; ++step) {
-        Equatorial const position_planet = planet_position_equatorial(planet, &it);
-        Horizontal const position = observe_geographic(&position_planet, &spec->observer, &it);
+        Equatorial const position_object = object_position(object, &it);
+        Horizontal const position = observe_geographic_ctx(&position_object, context, &it);
         result->altitudes[step] = position.altitude;
         result->azimuths[step] = position.azimuth;
         time_add(&it, (s64) spec->step_size, spec->unit);
     }
 }
 
-/// Compute the geographic position of the specified fixed object according
-/// to the specification
-void compute_geographic_fixed(MemoryArena *arena,
-                              ComputeResult *result,
-                              Object const *const object,
-                              ComputeSpecification const *const spec) {
-    result->altitudes = (f64 *) memory_arena_alloc(arena, spec->steps * sizeof(f64));
-    result->azimuths = (f64 *) memory_arena_alloc(arena, spec->steps * sizeof(f64));
+/// Compute the geographic position of the specified planet according
+/// to the spec with a prepared observer context
+void compute_geographic_planet_ctx(MemoryArena *arena,
+                                   ComputeResult *result,
+                                   Planet const *const planet,
+                                   ObserverContext const *const context,
+                                   ComputeSpecification const *const spec) {
+    ComputeTimeline timeline;
+    if (compute_timeline_make(&timeline, spec)) {
+        compute_geographic_planet_timeline(arena, result, planet, context, &timeline);
+        return;
+    }
+
+    result->altitudes = (f64 *) memory_arena_alloc_aligned(arena, spec->steps * sizeof(f64), ALIGNMENT64);
+    result->azimuths = (f64 *) memory_arena_alloc_aligned(arena, spec->steps * sizeof(f64), ALIGNMENT64);
     result->count = spec->steps;
 
     Time it = spec->date;
     for (usize step = 0; step < spec->steps; ++step) {
-        Equatorial const position_object = object_position(object, &it);
-        Horizontal const position = observe_geographic(&position_object, &spec->observer, &it);
+        Equatorial const position_planet = planet_position_equatorial(planet, &it);
+        Horizontal const position = observe_geographic_ctx(&position_planet, context, &it);
         result->altitudes[step] = position.altitude;
         result->azimuths[step] = position.azimuth;
         time_add(&it, (s64) spec->step_size, spec->unit);
     }
 }
+
+/// Compute the geographic position of the specified fixed object according
+/// to the specification with a prepared observer context
+void compute_geographic_fixed_ctx(MemoryArena *arena,
+                                  ComputeResult *result,
+                                  Object const *const object,
+                                  ObserverContext const *const context,
+                                  ComputeSpecification const *const spec) {
+    ComputeTimeline timeline;
+    if (compute_timeline_make(&timeline, spec)) {
+        compute_geographic_fixed_timeline(arena, result, object, context, &timeline);
+        return;
+    }
+
+    result->altitudes = (f64 *) memory_arena_alloc_aligned(arena, spec->steps * sizeof(f64), ALIGNMENT64);
+    result->azimuths = (f64 *) memory_arena_alloc_aligned(arena, spec->steps * sizeof(f64), ALIGNMENT64);
+    result->count = spec->steps;
+    compute_fixed_calendar(result, object, context, spec);
+}
+
+/// Compute the geographic position of the specified planet along the timeline
+void compute_geographic_planet_timeline(MemoryArena *arena,
+                                        ComputeResult *result,
+                                        Planet const *const planet,
+                                        ObserverContext const *const context,
+                                        ComputeTimeline const *const timeline) {
+    result->altitudes = (f64 *) memory_arena_alloc_aligned(arena, timeline->steps * sizeof(f64), ALIGNMENT64);
+    result->azimuths = (f64 *) memory_arena_alloc_aligned(arena, timeline->steps * sizeof(f64), ALIGNMENT64);
+    result->count = timeline->steps;
+    compute_planet_timeline_range(result, planet, context, timeline, 0, timeline->steps);
+}
+
+/// Compute the geographic position of the specified fixed object along the timeline
+void compute_geographic_fixed_timeline(MemoryArena *arena,
+                                       ComputeResult *result,
+                                       Object const *const object,
+                                       ObserverContext const *const context,
+                                       ComputeTimeline const *const timeline) {
+    result->altitudes = (f64 *) memory_arena_alloc_aligned(arena, timeline->steps * sizeof(f64), ALIGNMENT64);
+    result->azimuths = (f64 *) memory_arena_alloc_aligned(arena, timeline->steps * sizeof(f64), ALIGNMENT64);
+    result->count = timeline->steps;
+    compute_fixed_timeline_range(result, object, context, timeline, 0, timeline->steps);
+}
+
+/// Compute the geographic position of the planet of the ephemeris along the timeline
+void compute_geographic_ephemeris(MemoryArena *arena,
+                                  ComputeResult *result,
+                                  Ephemeris const *const ephemeris,
+                                  ObserverContext const *const context,
+                                  ComputeTimeline const *const timeline) {
+    result->altitudes = (f64 *) memory_arena_alloc_aligned(arena, timeline->steps * sizeof(f64), ALIGNMENT64);
+    result->azimuths = (f64 *) memory_arena_alloc_aligned(arena, timeline->steps * sizeof(f64), ALIGNMENT64);
+    result->count = timeline->steps;
+
+    for (usize step = 0; step < timeline->steps; ++step) {
+        f64 const jdn = timeline->start + (f64) step * timeline->step;
+        Vector3 const position = ephemeris_vector(ephemeris, jdn);
+        Matrix3x3 const transform = matrix3x3_horizontal(context, jdn);
+        Vector3 const local = matrix3x3_mul_vector3(&transform, &position);
+        Horizontal const horizontal = horizontal_from_vector3(&local);
+        result->altitudes[step] = horizontal.altitude;
+        result->azimuths[step] = horizontal.azimuth;
+    }
+}
+
+/// Creates the transform from mean equatorial coordinates of the catalog epoch into the horizontal system
+static Matrix3x3 compute_sky_transform(ObserverContext const *const context, f64 const jdn) {
+    // Precession, sidereal time and latitude are the same for every object, so they are fused once
+    Matrix3x3 const chain[] = { matrix3x3_horizontal(context, jdn), object_precession_jdn(jdn) };
+    return matrix3x3_mul_chain(chain, ARRAY_SIZE(chain));
+}
+
+/// Computes the horizontal positions of the catalog objects [begin, end)
+static void compute_sky_snapshot_range(MemoryArena *scratch,
+                                       ComputeResult const *const result,
+                                       Catalog const *const catalog,
+                                       Matrix3x3 const *const transform,
+                                       usize const begin,
+                                       usize const end) {
+    ObjectColumns const *const columns = &catalog->columns;
+    if (columns->count == catalog->object_count) {
+        usize const count = end - begin;
+        f64 *const x = (f64 *) memory_arena_alloc(scratch, count * sizeof(f64));
+        f64 *const y = (f64 *) memory_arena_alloc(scratch, count * sizeof(f64));
+        f64 *const z = (f64 *) memory_arena_alloc(scratch, count * sizeof(f64));
+        vector3_from_equatorial_batch(columns->right_ascensions + begin, columns->declinations + begin, nil, x, y, z,
+                                      count);
+
+        matrix3x3_mul_vector3_batch(transform, x, y, z, count);
+
+        // Horizontal coordinates are spherical coordinates of the horizontal system, see horizontal_from_vector3
+        f64 *const azimuths = result->azimuths + begin;
+        equatorial_from_vector3_batch(x, y, z, azimuths, result->altitudes + begin, nil, count);
+        for (usize i = 0; i < count; ++i) {
+            azimuths[i] += 180.0;
+        }
+        return;
+    }
+
+    for (usize i = begin; i < end; ++i) {
+        Vector3 const position = vector3_from_equatorial(&catalog->objects[i].position);
+        Vector3 const local = matrix3x3_mul_vector3(transform, &position);
+        Horizontal const horizontal = horizontal_from_vector3(&local);
+        result->altitudes[i] = horizontal.altitude;
+        result->azimuths[i] = horizontal.azimuth;
+    }
+}
+
+/// Compute the geographic position of every object in the catalog at one point in time
+void compute_sky_snapshot(MemoryArena *arena,
+                          ComputeResult *result,
+                          Catalog const *const catalog,
+                          Geographic const *const observer,
+                          Time const *const date) {
+    ObserverContext const context = observer_context_make(observer);
+    compute_sky_snapshot_ctx(arena, result, catalog, &context, time_jdn(date));
+}
+
+/// Compute the geographic position of every object in the catalog at one point in time
+/// with a prepared observer context
+void compute_sky_snapshot_ctx(MemoryArena *arena,
+                              ComputeResult *result,
+                              Catalog const *const catalog,
+                              ObserverContext const *const context,
+                              f64 const jdn) {
+    usize const count = catalog->object_count;
+    result->altitudes = (f64 *) memory_arena_alloc_aligned(arena, count * sizeof(f64), ALIGNMENT64);
+    result->azimuths = (f64 *) memory_arena_alloc_aligned(arena, count * sizeof(f64), ALIGNMENT64);
+    result->count = count;
+
+    // The rectangular scratch buffers do not outlive the snapshot
+    Matrix3x3 const transform = compute_sky_transform(context, jdn);
+    MemoryArenaMark const mark = memory_arena_mark(arena);
+    compute_sky_snapshot_range(arena, result, catalog, &transform, 0, count);
+    memory_arena_rewind(arena, mark);
+}
+
+typedef struct ComputeStepsJob {
+    ComputeResult const *result;
+    Planet const *planet;
+    Object const *object;
+    ObserverContext const *context;
+    ComputeTimeline const *timeline;
+} ComputeStepsJob;
+
+typedef struct ComputeObjectsJob {
+    ComputeResult const *results;
+    Object const *objects;
+    ObserverContext const *context;
+    ComputeSpecification const *spec;
+    ComputeTimeline timeline;
+    b8 timeline_valid;
+} ComputeObjectsJob;
+
+typedef struct ComputeSnapshotJob {
+    ComputeResult const *result;
+    Catalog const *catalog;
+    Matrix3x3 transform;
+} ComputeSnapshotJob;
+
+/// Computes a slice of the planet timeline
+static void compute_planet_steps_task(void *const data, usize const begin, usize const end, MemoryArena *arena) {
+    ComputeStepsJob const *const job = data;
+    (void) arena;
+    compute_planet_timeline_range(job->result, job->planet, job->context, job->timeline, begin, end);
+}
+
+/// Computes a slice of the object timeline
+static void compute_fixed_steps_task(void *const data, usize const begin, usize const end, MemoryArena *arena) {
+    ComputeStepsJob const *const job = data;
+    (void) arena;
+    compute_fixed_timeline_range(job->result, job->object, job->context, job->timeline, begin, end);
+}
+
+/// Computes the full series of a slice of the objects
+static void compute_objects_task(void *const data, usize const begin, usize const end, MemoryArena *arena) {
+    ComputeObjectsJob const *const job = data;
+    (void) arena;
+    for (usize i = begin; i < end; ++i) {
+        if (job->timeline_valid) {
+            compute_fixed_timeline_range(job->results + i, job->objects + i, job->context, &job->timeline, 0,
+                                         job->timeline.steps);
+        } else {
+            compute_fixed_calendar(job->results + i, job->objects + i, job->context, job->spec);
+        }
+    }
+}
+
+/// Computes a slice of the sky snapshot
+static void compute_snapshot_task(void *const data, usize const begin, usize const end, MemoryArena *arena) {
+    ComputeSnapshotJob const *const job = data;
+    compute_sky_snapshot_range(arena, job->result, job->catalog, &job->transform, begin, end);
+}
+
+/// Compute the geographic position of the specified planet according to the spec
+/// on the threads of the pool
+void compute_geographic_planet_parallel(ThreadPool *pool,
+                                        MemoryArena *arena,
+                                        ComputeResult *result,
+                                        Planet const *const planet,
+                                        ObserverContext const *const context,
+                                        ComputeSpecification const *const spec) {
+    ComputeTimeline timeline;
+    if (!compute_timeline_make(&timeline, spec)) {
+        compute_geographic_planet_ctx(arena, result, planet, context, spec);
+        return;
+    }
+
+    result->altitudes = (f64 *) memory_arena_alloc_aligned(arena, timeline.steps * sizeof(f64), ALIGNMENT64);
+    result->azimuths = (f64 *) memory_arena_alloc_aligned(arena, timeline.steps * sizeof(f64), ALIGNMENT64);
+    result->count = timeline.steps;
+
+    ComputeStepsJob job = { .result = result, .planet = planet, .context = context, .timeline = &timeline };
+    thread_pool_for(pool, timeline.steps, compute_planet_steps_task, &job);
+}
+
+/// Compute the geographic position of the specified fixed object according to the spec
+/// on the threads of the pool
+void compute_geographic_fixed_parallel(ThreadPool *pool,
+                                       MemoryArena *arena,
+                                       ComputeResult *result,
+                                       Object const *const object,
+                                       ObserverContext const *const context,
+                                       ComputeSpecification const *const spec) {
+    ComputeTimeline timeline;
+    if (!compute_timeline_make(&timeline, spec)) {
+        compute_geographic_fixed_ctx(arena, result, object, context, spec);
+        return;
+    }
+
+    result->altitudes = (f64 *) memory_arena_alloc_aligned(arena, timeline.steps * sizeof(f64), ALIGNMENT64);
+    result->azimuths = (f64 *) memory_arena_alloc_aligned(arena, timeline.steps * sizeof(f64), ALIGNMENT64);
+    result->count = timeline.steps;
+
+    ComputeStepsJob job = { .result = result, .object = object, .context = context, .timeline = &timeline };
+    thread_pool_for(pool, timeline.steps, compute_fixed_steps_task, &job);
+}
+
+/// Compute the geographic positions of the specified fixed objects according to the spec
+/// on the threads of the pool
+void compute_geographic_objects_parallel(ThreadPool *pool,
+                                         MemoryArena *arena,
+                                         ComputeResult *results,
+                                         Object const *const objects,
+                                         usize const count,
+                                         ObserverContext const *const context,
+                                         ComputeSpecification const *const spec) {
+    // The arena is not shared with the workers, so every series is allocated up front. The
+    // stride is rounded up to whole cache lines, so every series is aligned and no two share a line
+    usize const lane = ALIGNMENT64 / sizeof(f64);
+    usize const stride = (spec->steps + lane - 1) / lane * lane;
+    usize const size = count * stride * sizeof(f64);
+    f64 *const altitudes = (f64 *) memory_arena_alloc_aligned(arena, size, ALIGNMENT64);
+    f64 *const azimuths = (f64 *) memory_arena_alloc_aligned(arena, size, ALIGNMENT64);
+    for (usize i = 0; i < count; ++i) {
+        results[i].altitudes = altitudes + i * stride;
+        results[i].azimuths = azimuths + i * stride;
+        results[i].count = spec->steps;
+    }
+
+    ComputeObjectsJob job = { .results = results, .objects = objects, .context = context, .spec = spec };
+    job.timeline_valid = compute_timeline_make(&job.timeline, spec);
+    thread_pool_for(pool, count, compute_objects_task, &job);
+}
+
+/// Compute the geographic position of every object in the catalog at one point in time
+/// on the threads of the pool
+void compute_sky_snapshot_parallel(ThreadPool *pool,
+                                   MemoryArena *arena,
+                                   ComputeResult *result,
+                                   Catalog const *const catalog,
+                                   ObserverContext const *const context,
+                                   f64 const jdn) {
+    usize const count = catalog->object_count;
+    result->altitudes = (f64 *) memory_arena_alloc_aligned(arena, count * sizeof(f64), ALIGNMENT64);
+    result->azimuths = (f64 *) memory_arena_alloc_aligned(arena, count * sizeof(f64), ALIGNMENT64);
+    result->count = count;
+
+    ComputeSnapshotJob job = { .result = result, .catalog = catalog, .transform = compute_sky_transform(context, jdn) };
+    thread_pool_for(pool, count, compute_snapshot_task, &job);
+}
@@ -0,0 +1,68 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Elias Engelbert Plank
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SOLARIS_DISPATCH_H
+#define SOLARIS_DISPATCH_H
+
+#include <solaris/types.h>
+
+// Runtime CPU dispatch for the batch kernels (internal use only).
+//
+// Batch kernels are written as plain, branch-free C loops which the compiler
+// vectorizes. On x86 with GCC/Clang, the same loop is additionally compiled
+// for AVX2 and AVX-512 with the `target` attribute and the best variant is
+// selected at runtime. The baseline variant uses SSE2, which every x86-64
+// processor supports. Other platforms and compilers use the baseline only.
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DISPATCH_X86 1
+#define DISPATCH_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define DISPATCH_TARGET_AVX512 __attribute__((target("avx512f,avx512dq,avx2,fma")))
+#else
+#define DISPATCH_X86 0
+#endif
+
+// Fully unrolls fixed inner loops, so that the surrounding loop can be vectorized
+#if defined(__clang__)
+#define DISPATCH_UNROLL _Pragma("unroll")
+#elif defined(__GNUC__)
+#define DISPATCH_UNROLL _Pragma("GCC unroll 16")
+#else
+#define DISPATCH_UNROLL
+#endif
+
+#if defined(__GNUC__)
+#define DISPATCH_INLINE static inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define DISPATCH_INLINE static __forceinline
+#else
+#define DISPATCH_INLINE static inline
+#endif
+
+typedef enum DispatchLevel { DISPATCH_LEVEL_BASELINE, DISPATCH_LEVEL_AVX2, DISPATCH_LEVEL_AVX512 } DispatchLevel;
+
+/// Retrieves the best dispatch level that is supported by the processor
+/// @return The dispatch level
+DispatchLevel dispatch_level(void);
+
+#endif// SOLARIS_DISPATCH_H
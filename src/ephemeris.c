@@ -0,0 +1,131 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Elias Engelbert Plank
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <solaris/ephemeris.h>
+#include <solaris/math.h>
+
+enum {
+    EPHEMERIS_ORDER = 14,
+    EPHEMERIS_MAX_ORDER = 32,
+};
+
+/// Default length of a segment in days
+static f64 const EPHEMERIS_SEGMENT_LENGTH = 16.0;
+
+/// Retrieves the coefficients of the axis in the segment
+static f64 *ephemeris_coefficients(Ephemeris const *const ephemeris, usize const segment, usize const axis) {
+    return ephemeris->coefficients + (segment * 3 + axis) * ephemeris->order;
+}
+
+/// Fits the coefficients of one segment at the chebyshev nodes
+static void ephemeris_fit_segment(Ephemeris const *const ephemeris, usize const segment) {
+    usize const order = ephemeris->order;
+    f64 const half = 0.5 * ephemeris->segment_length;
+    f64 const middle = ephemeris->start + (f64) segment * ephemeris->segment_length + half;
+
+    f64 samples[3][EPHEMERIS_MAX_ORDER];
+    for (usize k = 0; k < order; ++k) {
+        f64 const node = math_cosine(180.0 * ((f64) k + 0.5) / (f64) order);
+        Vector3 const position = planet_position_vector_jdn(ephemeris->planet, middle + half * node);
+        samples[0][k] = position.x;
+        samples[1][k] = position.y;
+        samples[2][k] = position.z;
+    }
+
+    for (usize axis = 0; axis < 3; ++axis) {
+        f64 *const coefficients = ephemeris_coefficients(ephemeris, segment, axis);
+        for (usize j = 0; j < order; ++j) {
+            f64 sum = 0.0;
+            for (usize k = 0; k < order; ++k) {
+                sum += samples[axis][k] * math_cosine(180.0 * (f64) j * ((f64) k + 0.5) / (f64) order);
+            }
+            coefficients[j] = 2.0 * sum / (f64) order;
+        }
+        coefficients[0] *= 0.5;
+    }
+}
+
+/// Evaluates the chebyshev series at x in [-1, 1] using clenshaw's recurrence
+static f64 ephemeris_clenshaw(f64 const *const coefficients, usize const order, f64 const x) {
+    f64 const x2 = 2.0 * x;
+    f64 b1 = 0.0;
+    f64 b2 = 0.0;
+    for (usize j = order - 1; j > 0; --j) {
+        f64 const b0 = coefficients[j] + x2 * b1 - b2;
+        b2 = b1;
+        b1 = b0;
+    }
+    return coefficients[0] + x * b1 - b2;
+}
+
+/// Fits the ephemeris of the planet for the specified range
+void ephemeris_make(MemoryArena *arena,
+                    Ephemeris *ephemeris,
+                    Planet const *const planet,
+                    f64 const start,
+                    f64 const end,
+                    f64 const segment_length,
+                    usize const order) {
+    ephemeris->planet = planet;
+    ephemeris->start = start;
+    ephemeris->segment_length = segment_length > 0.0 ? segment_length : EPHEMERIS_SEGMENT_LENGTH;
+    ephemeris->order = order == 0 ? EPHEMERIS_ORDER : order;
+    if (ephemeris->order > EPHEMERIS_MAX_ORDER) {
+        ephemeris->order = EPHEMERIS_MAX_ORDER;
+    }
+
+    f64 const segments = end > start ? math_floor((end - start) / ephemeris->segment_length) + 1.0 : 1.0;
+    ephemeris->segment_count = (usize) segments;
+    ephemeris->coefficients =
+            (f64 *) memory_arena_alloc(arena, ephemeris->segment_count * 3 * ephemeris->order * sizeof(f64));
+
+    for (usize segment = 0; segment < ephemeris->segment_count; ++segment) {
+        ephemeris_fit_segment(ephemeris, segment);
+    }
+}
+
+/// Evaluates the geocentric equatorial position of the ephemeris in cartesian coordinates
+Vector3 ephemeris_vector(Ephemeris const *const ephemeris, f64 const jdn) {
+    f64 const offset = (jdn - ephemeris->start) / ephemeris->segment_length;
+    if (!(offset >= 0.0 && offset <= (f64) ephemeris->segment_count)) {
+        return planet_position_vector_jdn(ephemeris->planet, jdn);
+    }
+
+    usize segment = (usize) offset;
+    if (segment == ephemeris->segment_count) {
+        segment--;
+    }
+    f64 const x = 2.0 * (offset - (f64) segment) - 1.0;
+
+    Vector3 result;
+    result.x = ephemeris_clenshaw(ephemeris_coefficients(ephemeris, segment, 0), ephemeris->order, x);
+    result.y = ephemeris_clenshaw(ephemeris_coefficients(ephemeris, segment, 1), ephemeris->order, x);
+    result.z = ephemeris_clenshaw(ephemeris_coefficients(ephemeris, segment, 2), ephemeris->order, x);
+    return result;
+}
+
+/// Evaluates the equatorial position of the ephemeris
+Equatorial ephemeris_position(Ephemeris const *const ephemeris, f64 const jdn) {
+    Vector3 const position = ephemeris_vector(ephemeris, jdn);
+    return equatorial_from_vector3(&position);
+}
@@ -0,0 +1,552 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Elias Engelbert Plank
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <float.h>
+#include <stdlib.h>
+
+#include <solaris/event.h>
+#include <solaris/math.h>
+
+enum {
+    EVENT_SAMPLES = 24,
+    EVENT_MAX_ITERATIONS = 64,
+    EVENT_MAX_BODIES = PLANET_COUNT + 1,
+    EVENT_MAX_PAIRS = EVENT_MAX_BODIES * (EVENT_MAX_BODIES - 1) / 2,
+};
+
+/// Tolerance of the refined events in days, which is below 10 milliseconds
+static f64 const EVENT_TOLERANCE = 1.0e-7;
+
+/// Sampling step of the planet event search in days
+static f64 const EVENT_SEARCH_STEP = 1.0;
+
+/// Tolerance of the refined planet events in days, which is about a second
+static f64 const EVENT_SEARCH_TOLERANCE = 1.0e-5;
+
+/// Extrema whose samples exceed the tolerance by more than the margin in degrees are not refined
+static f64 const EVENT_SEARCH_MARGIN = 5.0;
+
+/// Elongation that separates oppositions from the greatest elongations of the inner planets
+static f64 const EVENT_OPPOSITION_ELONGATION = 90.0;
+
+/// Inverse of the golden ratio
+static f64 const EVENT_GOLDEN = 0.61803398874989485;
+
+/// Function whose roots are searched
+typedef f64 (*EventFunc)(void const *state, f64 jdn);
+
+/// Body whose horizon crossings are searched, the position of fixed objects
+/// is precessed once for the whole day as it barely changes
+typedef struct EventBody {
+    ObserverContext const *context;
+    Planet const *planet;
+    Vector3 position;
+    f64 horizon;
+} EventBody;
+
+/// Retrieves the geocentric equatorial position of the body
+static Vector3 event_body_position(EventBody const *const body, f64 const jdn) {
+    return body->planet != nil ? planet_position_vector_jdn(body->planet, jdn) : body->position;
+}
+
+/// Wraps the angle into the range (-180, 180]
+static f64 event_wrap(f64 const angle) {
+    f64 const result = math_modulo(angle, 360.0);
+    if (result > 180.0) {
+        return result - 360.0;
+    }
+    if (result <= -180.0) {
+        return result + 360.0;
+    }
+    return result;
+}
+
+/// Computes the altitude above the horizon and the hour angle of the position
+static void event_observe(EventBody const *const body,
+                          Vector3 const *const position,
+                          f64 const jdn,
+                          f64 *const altitude,
+                          f64 *const hour_angle) {
+    Matrix3x3 const transform = matrix3x3_horizontal(body->context, jdn);
+    Vector3 const local = matrix3x3_mul_vector3(&transform, position);
+    *altitude = math_arc_tangent2(local.z, math_sqrt(local.x * local.x + local.y * local.y)) - body->horizon;
+    *hour_angle = event_wrap(observer_context_lmst(body->context, jdn) - math_arc_tangent2(position->y, position->x));
+}
+
+/// Altitude of the body above the horizon
+static f64 event_altitude(void const *const state, f64 const jdn) {
+    EventBody const *const body = state;
+    Vector3 const position = event_body_position(body, jdn);
+    f64 altitude;
+    f64 hour_angle;
+    event_observe(body, &position, jdn, &altitude, &hour_angle);
+    return altitude;
+}
+
+/// Hour angle of the body
+static f64 event_hour_angle(void const *const state, f64 const jdn) {
+    EventBody const *const body = state;
+    Vector3 const position = event_body_position(body, jdn);
+    f64 altitude;
+    f64 hour_angle;
+    event_observe(body, &position, jdn, &altitude, &hour_angle);
+    return hour_angle;
+}
+
+/// Finds the root of the function within the bracket [a, b] using brent's method
+static f64 event_brent(EventFunc const func, void const *const state, f64 a, f64 b, f64 fa, f64 fb) {
+    f64 c = a;
+    f64 fc = fa;
+    f64 d = b - a;
+    f64 e = d;
+    for (usize iteration = 0; iteration < EVENT_MAX_ITERATIONS; ++iteration) {
+        if (math_abs(fc) < math_abs(fb)) {
+            a = b;
+            b = c;
+            c = a;
+            fa = fb;
+            fb = fc;
+            fc = fa;
+        }
+
+        f64 const tolerance = 2.0 * DBL_EPSILON * math_abs(b) + 0.5 * EVENT_TOLERANCE;
+        f64 const middle = 0.5 * (c - b);
+        if (math_abs(middle) <= tolerance || fb == 0.0) {
+            break;
+        }
+
+        if (math_abs(e) >= tolerance && math_abs(fa) > math_abs(fb)) {
+            // Inverse quadratic interpolation, or the secant if only two points are known
+            f64 const s = fb / fa;
+            f64 p;
+            f64 q;
+            if (a == c) {
+                p = 2.0 * middle * s;
+                q = 1.0 - s;
+            } else {
+                f64 const r = fb / fc;
+                q = fa / fc;
+                p = s * (2.0 * middle * q * (q - r) - (b - a) * (r - 1.0));
+                q = (q - 1.0) * (r - 1.0) * (s - 1.0);
+            }
+            if (p > 0.0) {
+                q = -q;
+            } else {
+                p = -p;
+            }
+
+            f64 const limit = 3.0 * middle * q - math_abs(tolerance * q);
+            if (2.0 * p < limit && 2.0 * p < math_abs(e * q)) {
+                e = d;
+                d = p / q;
+            } else {
+                d = middle;
+                e = d;
+            }
+        } else {
+            d = middle;
+            e = d;
+        }
+
+        a = b;
+        fa = fb;
+        b += math_abs(d) > tolerance ? d : (middle > 0.0 ? tolerance : -tolerance);
+        fb = func(state, b);
+        if ((fb > 0.0) == (fc > 0.0)) {
+            c = a;
+            fc = fa;
+            d = b - a;
+            e = d;
+        }
+    }
+    return b;
+}
+
+/// Searches the brackets of the hourly samples and refines the events
+static RiseTransitSet event_rise_transit_set_refine(EventBody const *const body,
+                                                    f64 const jdn,
+                                                    f64 const *const altitudes,
+                                                    f64 const *const hour_angles) {
+    RiseTransitSet result = { 0 };
+    b8 above = true;
+    for (usize i = 0; i < EVENT_SAMPLES; ++i) {
+        f64 const begin = jdn + (f64) i / EVENT_SAMPLES;
+        f64 const end = jdn + (f64) (i + 1) / EVENT_SAMPLES;
+        above = above && altitudes[i] >= 0.0;
+
+        if (!result.rises && altitudes[i] < 0.0 && altitudes[i + 1] >= 0.0) {
+            result.rise = event_brent(event_altitude, body, begin, end, altitudes[i], altitudes[i + 1]);
+            result.rises = true;
+        }
+        if (!result.sets && altitudes[i] >= 0.0 && altitudes[i + 1] < 0.0) {
+            result.set = event_brent(event_altitude, body, begin, end, altitudes[i], altitudes[i + 1]);
+            result.sets = true;
+        }
+
+        // The hour angle jumps from 180 to -180 at the lower culmination, which is no root
+        f64 const hour_angle_change = hour_angles[i + 1] - hour_angles[i];
+        if (!result.transits && hour_angles[i] < 0.0 && hour_angles[i + 1] >= 0.0 && hour_angle_change < 180.0) {
+            result.transit = event_brent(event_hour_angle, body, begin, end, hour_angles[i], hour_angles[i + 1]);
+            result.transit_altitude = event_altitude(body, result.transit) + body->horizon;
+            result.transits = true;
+        }
+    }
+    result.circumpolar = above && altitudes[EVENT_SAMPLES] >= 0.0;
+    return result;
+}
+
+/// Samples the body every hour and refines the events
+static RiseTransitSet event_rise_transit_set(EventBody const *const body, f64 const jdn) {
+    f64 altitudes[EVENT_SAMPLES + 1];
+    f64 hour_angles[EVENT_SAMPLES + 1];
+    for (usize i = 0; i <= EVENT_SAMPLES; ++i) {
+        f64 const sample = jdn + (f64) i / EVENT_SAMPLES;
+        Vector3 const position = event_body_position(body, sample);
+        event_observe(body, &position, sample, altitudes + i, hour_angles + i);
+    }
+    return event_rise_transit_set_refine(body, jdn, altitudes, hour_angles);
+}
+
+/// Creates the body of a fixed object, precessed to the middle of the day
+static EventBody event_body_object(Object const *const object,
+                                   ObserverContext const *const context,
+                                   Matrix3x3 const *const precession,
+                                   f64 const horizon) {
+    Vector3 const position = vector3_from_equatorial(&object->position);
+    EventBody body;
+    body.context = context;
+    body.planet = nil;
+    body.position = matrix3x3_mul_vector3(precession, &position);
+    body.horizon = horizon;
+    return body;
+}
+
+/// Retrieves the julian day number of local midnight of the date
+static f64 event_midnight_jdn(Time const *const date) {
+    Time const midnight = { date->year, date->month, date->day, 0, 0, 0, 0 };
+    return time_jdn(&midnight);
+}
+
+/// Finds the rise, transit and set of the fixed object on the specified day
+RiseTransitSet find_rise_transit_set_object(Object const *const object,
+                                            Geographic const *const observer,
+                                            Time const *const date,
+                                            f64 const horizon) {
+    ObserverContext const context = observer_context_make(observer);
+    return find_rise_transit_set_object_ctx(object, &context, event_midnight_jdn(date), horizon);
+}
+
+/// Finds the rise, transit and set of the planet on the specified day
+RiseTransitSet find_rise_transit_set_planet(Planet const *const planet,
+                                            Geographic const *const observer,
+                                            Time const *const date,
+                                            f64 const horizon) {
+    ObserverContext const context = observer_context_make(observer);
+    return find_rise_transit_set_planet_ctx(planet, &context, event_midnight_jdn(date), horizon);
+}
+
+/// Finds the rise, transit and set of the fixed object within one day
+RiseTransitSet find_rise_transit_set_object_ctx(Object const *const object,
+                                                ObserverContext const *const context,
+                                                f64 const jdn,
+                                                f64 const horizon) {
+    Matrix3x3 const precession = object_precession_jdn(jdn + 0.5);
+    EventBody const body = event_body_object(object, context, &precession, horizon);
+    return event_rise_transit_set(&body, jdn);
+}
+
+/// Finds the rise, transit and set of the planet within one day
+RiseTransitSet find_rise_transit_set_planet_ctx(Planet const *const planet,
+                                                ObserverContext const *const context,
+                                                f64 const jdn,
+                                                f64 const horizon) {
+    EventBody body;
+    body.context = context;
+    body.planet = planet;
+    body.position = (Vector3) { 0.0, 0.0, 0.0 };
+    body.horizon = horizon;
+    return event_rise_transit_set(&body, jdn);
+}
+
+/// Finds the rise, transit and set of every object in the catalog within one day
+void find_rise_transit_set_catalog(MemoryArena *arena,
+                                   RiseTransitSetResult *result,
+                                   Catalog const *const catalog,
+                                   ObserverContext const *const context,
+                                   f64 const jdn,
+                                   f64 const horizon) {
+    result->events = (RiseTransitSet *) memory_arena_alloc(arena, catalog->object_count * sizeof(RiseTransitSet));
+    result->count = catalog->object_count;
+
+    // Sidereal time is the same for every object, so the transforms of the samples are shared
+    Matrix3x3 transforms[EVENT_SAMPLES + 1];
+    f64 lmst[EVENT_SAMPLES + 1];
+    for (usize i = 0; i <= EVENT_SAMPLES; ++i) {
+        f64 const sample = jdn + (f64) i / EVENT_SAMPLES;
+        transforms[i] = matrix3x3_horizontal(context, sample);
+        lmst[i] = observer_context_lmst(context, sample);
+    }
+
+    Matrix3x3 const precession = object_precession_jdn(jdn + 0.5);
+    for (usize object = 0; object < catalog->object_count; ++object) {
+        EventBody const body = event_body_object(catalog->objects + object, context, &precession, horizon);
+        f64 const right_ascension = math_arc_tangent2(body.position.y, body.position.x);
+
+        f64 altitudes[EVENT_SAMPLES + 1];
+        f64 hour_angles[EVENT_SAMPLES + 1];
+        for (usize i = 0; i <= EVENT_SAMPLES; ++i) {
+            Vector3 const local = matrix3x3_mul_vector3(transforms + i, &body.position);
+            altitudes[i] = math_arc_tangent2(local.z, math_sqrt(local.x * local.x + local.y * local.y)) - horizon;
+            hour_angles[i] = event_wrap(lmst[i] - right_ascension);
+        }
+        result->events[object] = event_rise_transit_set_refine(&body, jdn, altitudes, hour_angles);
+    }
+}
+
+/// Bodies of the planet event search, the planets of the catalog except for
+/// the earth and the sun as last body
+typedef struct EventSky {
+    Planet const *planets[EVENT_MAX_BODIES];
+    u32 bits[EVENT_MAX_BODIES];
+    usize count;
+    TransformCache *cache;
+} EventSky;
+
+/// Function that is minimized, the (signed) largest separation of the bodies
+typedef struct EventObjective {
+    EventSky const *sky;
+    usize bodies[EVENT_MAX_BODIES];
+    usize count;
+    f64 sign;
+} EventObjective;
+
+/// Dynamic list of the found events, which grows in the arena of the caller
+typedef struct EventList {
+    MemoryArena *arena;
+    Event *events;
+    usize count;
+    usize capacity;
+    b8 failed;
+} EventList;
+
+/// Retrieves the position of the body of the sky
+static Vector3 event_sky_position(EventSky const *const sky, usize const body, f64 const jdn) {
+    if (sky->planets[body] == nil) {
+        return sun_position_vector_cache(sky->cache, jdn);
+    }
+    return planet_position_vector_cache(sky->planets[body], sky->cache, jdn);
+}
+
+/// Computes the angular separation of the two positions in degrees
+static f64 event_separation(Vector3 const *const a, Vector3 const *const b) {
+    Vector3 const cross = { a->y * b->z - a->z * b->y, a->z * b->x - a->x * b->z, a->x * b->y - a->y * b->x };
+    return math_arc_tangent2(vector3_length(&cross), a->x * b->x + a->y * b->y + a->z * b->z);
+}
+
+/// Computes the largest separation of the positions
+static f64 event_spread(Vector3 const *const positions, usize const *const bodies, usize const count) {
+    f64 result = 0.0;
+    for (usize i = 0; i < count; ++i) {
+        for (usize j = i + 1; j < count; ++j) {
+            f64 const separation = event_separation(positions + bodies[i], positions + bodies[j]);
+            result = separation > result ? separation : result;
+        }
+    }
+    return result;
+}
+
+/// Evaluates the objective at the specified point in time
+static f64 event_objective(EventObjective const *const objective, f64 const jdn) {
+    Vector3 positions[EVENT_MAX_BODIES];
+    for (usize i = 0; i < objective->count; ++i) {
+        positions[objective->bodies[i]] = event_sky_position(objective->sky, objective->bodies[i], jdn);
+    }
+    return objective->sign * event_spread(positions, objective->bodies, objective->count);
+}
+
+/// Finds the minimum of the objective within [a, b] using a golden section search
+static f64 event_golden(EventObjective const *const objective, f64 a, f64 b, f64 *const minimum) {
+    f64 c = b - EVENT_GOLDEN * (b - a);
+    f64 d = a + EVENT_GOLDEN * (b - a);
+    f64 fc = event_objective(objective, c);
+    f64 fd = event_objective(objective, d);
+    while (b - a > EVENT_SEARCH_TOLERANCE) {
+        if (fc < fd) {
+            b = d;
+            d = c;
+            fd = fc;
+            c = b - EVENT_GOLDEN * (b - a);
+            fc = event_objective(objective, c);
+        } else {
+            a = c;
+            c = d;
+            fc = fd;
+            d = a + EVENT_GOLDEN * (b - a);
+            fd = event_objective(objective, d);
+        }
+    }
+    *minimum = fc < fd ? fc : fd;
+    return fc < fd ? c : d;
+}
+
+/// Refines the extremum of the bodies within [a, b] and appends it if it is an event
+static void event_refine(EventList *const list,
+                         EventObjective const *const objective,
+                         EventKind const kind,
+                         f64 const a,
+                         f64 const b,
+                         f64 const tolerance) {
+    f64 minimum;
+    f64 const jdn = event_golden(objective, a, b, &minimum);
+    f64 const separation = objective->sign * minimum;
+    if (kind != EVENT_OPPOSITION && separation > tolerance) {
+        return;
+    }
+
+    if (list->failed) {
+        return;
+    }
+    if (list->count == list->capacity) {
+        // Growth is geometric, so the outgrown arrays take less memory than the final one
+        usize const capacity = list->capacity == 0 ? 64 : list->capacity * 2;
+        Event *const events = (Event *) memory_arena_alloc(list->arena, capacity * sizeof(Event));
+        if (events == nil) {
+            list->failed = true;
+            return;
+        }
+        for (usize i = 0; i < list->count; ++i) {
+            events[i] = list->events[i];
+        }
+        list->events = events;
+        list->capacity = capacity;
+    }
+    Event *const event = list->events + list->count++;
+    event->kind = kind;
+    event->jdn = jdn;
+    event->separation = separation;
+    event->bodies = 0;
+    for (usize i = 0; i < objective->count; ++i) {
+        event->bodies |= objective->sky->bits[objective->bodies[i]];
+    }
+}
+
+/// Compares two events by time for sorting
+static int event_compare(void const *const a, void const *const b) {
+    f64 const left = ((Event const *) a)->jdn;
+    f64 const right = ((Event const *) b)->jdn;
+    return (left > right) - (left < right);
+}
+
+/// Finds the conjunctions, oppositions and alignments of the planets and the sun
+void find_planet_events(MemoryArena *arena,
+                        EventResult *result,
+                        Catalog const *const catalog,
+                        EventSpecification const *const spec) {
+    // All bodies at one point in time share the transform, epochs are not rounded
+    TransformCache cache = transform_cache_make(0.0);
+    EventSky sky = { 0 };
+    sky.cache = &cache;
+    for (usize i = 0; i < catalog->planet_count && sky.count < PLANET_COUNT; ++i) {
+        if (catalog->planets[i].name != PLANET_EARTH) {
+            sky.planets[sky.count] = catalog->planets + i;
+            sky.bits[sky.count++] = EVENT_BODY(catalog->planets[i].name);
+        }
+    }
+    usize const sun = sky.count;
+    sky.planets[sky.count] = nil;
+    sky.bits[sky.count++] = EVENT_BODY_SUN;
+
+    // Every pair is a candidate for a conjunction, pairs with the sun also for an opposition
+    EventObjective pairs[EVENT_MAX_PAIRS];
+    usize pair_count = 0;
+    for (usize i = 0; i < sky.count; ++i) {
+        for (usize j = i + 1; j < sky.count; ++j) {
+            EventObjective *const pair = pairs + pair_count++;
+            pair->sky = &sky;
+            pair->bodies[0] = i;
+            pair->bodies[1] = j;
+            pair->count = 2;
+            pair->sign = 1.0;
+        }
+    }
+    EventObjective alignment = { .sky = &sky, .count = 0, .sign = 1.0 };
+    for (usize i = 0; i < sky.count; ++i) {
+        if ((spec->alignment & sky.bits[i]) != 0) {
+            alignment.bodies[alignment.count++] = i;
+        }
+    }
+
+    // Separations of the last three samples, the middle one is checked for an extremum
+    f64 separations[3][EVENT_MAX_PAIRS];
+    f64 spreads[3];
+    EventList list = { .arena = arena, .events = nil, .count = 0, .capacity = 0, .failed = false };
+    usize const samples = spec->end > spec->start ? (usize) ((spec->end - spec->start) / EVENT_SEARCH_STEP) + 1 : 0;
+    for (usize sample = 0; sample < samples; ++sample) {
+        f64 const jdn = spec->start + (f64) sample * EVENT_SEARCH_STEP;
+        Vector3 positions[EVENT_MAX_BODIES];
+        for (usize i = 0; i < sky.count; ++i) {
+            positions[i] = event_sky_position(&sky, i, jdn);
+        }
+        for (usize pair = 0; pair < pair_count; ++pair) {
+            separations[sample % 3][pair] = event_spread(positions, pairs[pair].bodies, 2);
+        }
+        spreads[sample % 3] = event_spread(positions, alignment.bodies, alignment.count);
+        if (sample < 2) {
+            continue;
+        }
+
+        f64 const begin = jdn - 2.0 * EVENT_SEARCH_STEP;
+        f64 const *const before = separations[(sample - 2) % 3];
+        f64 const *const middle = separations[(sample - 1) % 3];
+        f64 const *const after = separations[sample % 3];
+        for (usize pair = 0; pair < pair_count; ++pair) {
+            if (middle[pair] < before[pair] && middle[pair] <= after[pair] &&
+                middle[pair] <= spec->tolerance + EVENT_SEARCH_MARGIN) {
+                event_refine(&list, pairs + pair, EVENT_CONJUNCTION, begin, jdn, spec->tolerance);
+            }
+            if (pairs[pair].bodies[1] == sun && middle[pair] > before[pair] && middle[pair] >= after[pair] &&
+                middle[pair] > EVENT_OPPOSITION_ELONGATION) {
+                EventObjective opposition = pairs[pair];
+                opposition.sign = -1.0;
+                event_refine(&list, &opposition, EVENT_OPPOSITION, begin, jdn, spec->tolerance);
+            }
+        }
+
+        f64 const spread = spreads[(sample - 1) % 3];
+        if (alignment.count > 2 && spread < spreads[(sample - 2) % 3] && spread <= spreads[sample % 3] &&
+            spread <= spec->tolerance + EVENT_SEARCH_MARGIN) {
+            event_refine(&list, &alignment, EVENT_ALIGNMENT, begin, jdn, spec->tolerance);
+        }
+    }
+
+    if (list.failed) {
+        result->events = nil;
+        result->count = 0;
+        return;
+    }
+    if (list.count > 0) {
+        qsort(list.events, list.count, sizeof(Event), event_compare);
+    }
+    result->events = list.events;
+    result->count = list.count;
+}
@@ -0,0 +1,266 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Elias Engelbert Plank
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef SOLARIS_KERNEL_H
+#define SOLARIS_KERNEL_H
+
+#include <math.h>
+
+#include <solaris/math.h>
+
+#include "dispatch.h"
+
+// Branch-free polynomial kernels for the batch functions (internal use only).
+//
+// The polynomials are the minimax approximations of the Cephes library and
+// are accurate to about one unit in the last place within the reduced range.
+// Selections are written as conditional expressions so that the compiler can
+// turn them into blends when it vectorizes the calling loop.
+
+/// Rounds to the nearest integer (ties to even) for |x| < 2^51
+DISPATCH_INLINE f64 kernel_round(f64 const x) {
+    f64 const magic = 6755399441055744.0;
+    return (x + magic) - magic;
+}
+
+/// Retrieves the square root of the value
+DISPATCH_INLINE f64 kernel_sqrt(f64 const x) {
+    // Requires -fno-math-errno to be vectorized
+    return sqrt(x);
+}
+
+/// Applies the quadrant q to sine and cosine of the reduced argument
+DISPATCH_INLINE void kernel_quadrant(f64 const s, f64 const c, f64 const q, f64 *const sine, f64 *const cosine) {
+    // Quadrant in [-2, 2], where -2 and 2 are the same quadrant
+    f64 const m = q - 4.0 * kernel_round(0.25 * q);
+    b8 const odd = m == 1.0 || m == -1.0;
+    f64 const sine_base = odd ? c : s;
+    f64 const cosine_base = odd ? s : c;
+    *sine = (m < 0.0 || m == 2.0) ? -sine_base : sine_base;
+    *cosine = (m >= 1.0 || m == -2.0) ? -cosine_base : cosine_base;
+}
+
+/// Computes sine and cosine of the reduced argument |x| <= pi/4 and applies the quadrant q
+DISPATCH_INLINE void kernel_sincos_quadrant(f64 const x, f64 const q, f64 *const sine, f64 *const cosine) {
+    f64 const z = x * x;
+
+    f64 s = 1.58962301576546568060e-10;
+    s = s * z - 2.50507477628578072866e-8;
+    s = s * z + 2.75573136213857245213e-6;
+    s = s * z - 1.98412698295895385996e-4;
+    s = s * z + 8.33333333332211858878e-3;
+    s = s * z - 1.66666666666666307295e-1;
+    s = x + x * z * s;
+
+    f64 c = -1.13585365213876817300e-11;
+    c = c * z + 2.08757008419747316778e-9;
+    c = c * z - 2.75573141792967388112e-7;
+    c = c * z + 2.48015872888517045348e-5;
+    c = c * z - 1.38888888888730564116e-3;
+    c = c * z + 4.16666666666665929218e-2;
+    c = 1.0 - 0.5 * z + z * z * c;
+
+    kernel_quadrant(s, c, q, sine, cosine);
+}
+
+/// Computes sine and cosine of the reduced argument |x| <= pi/4 with an error below 3e-12
+/// and applies the quadrant q
+DISPATCH_INLINE void kernel_sincos_quadrant_high(f64 const x, f64 const q, f64 *const sine, f64 *const cosine) {
+    f64 const z = x * x;
+
+    f64 s = 2.7158227627758065e-06;
+    s = s * z - 1.9839018265719525e-4;
+    s = s * z + 8.33332813087351e-3;
+    s = s * z - 1.666666662657951e-1;
+    s = x + x * z * s;
+
+    f64 c = -2.720820584924074e-07;
+    c = c * z + 2.4799491835561577e-5;
+    c = c * z - 1.3888883628060632e-3;
+    c = c * z + 4.166666662105924e-2;
+    c = 1.0 - 0.5 * z + z * z * c;
+
+    kernel_quadrant(s, c, q, sine, cosine);
+}
+
+/// Computes sine and cosine of the reduced argument |x| <= pi/4 with an error below 1e-7
+/// and applies the quadrant q
+DISPATCH_INLINE void kernel_sincos_quadrant_display(f64 const x, f64 const q, f64 *const sine, f64 *const cosine) {
+    f64 const z = x * x;
+
+    f64 s = -1.949349671195455e-4;
+    s = s * z + 8.331957976881126e-3;
+    s = s * z - 1.6666650192526541e-1;
+    s = x + x * z * s;
+
+    f64 c = -1.3650475942944698e-3;
+    c = c * z + 4.166116709010369e-2;
+    c = 1.0 - 0.5 * z + z * z * c;
+
+    kernel_quadrant(s, c, q, sine, cosine);
+}
+
+/// Computes sine and cosine of the angle in radians
+DISPATCH_INLINE void kernel_sincos(f64 const x, f64 *const sine, f64 *const cosine) {
+    // Cody-Waite reduction with pi/2 split into three parts
+    f64 const q = kernel_round(x * (2.0 / PI));
+    f64 r = x - q * 1.57079632673412561417e+00;
+    r -= q * 6.07710050630396597660e-11;
+    r -= q * 2.02226624871116645580e-21;
+    kernel_sincos_quadrant(r, q, sine, cosine);
+}
+
+/// Computes sine and cosine of the angle in degrees
+DISPATCH_INLINE void kernel_sincos_degrees(f64 const angle, f64 *const sine, f64 *const cosine) {
+    // Reduction by multiples of 90 degrees is exact
+    f64 const q = kernel_round(angle * (1.0 / 90.0));
+    f64 const r = angle - 90.0 * q;
+    kernel_sincos_quadrant(r * (PI / 180.0), q, sine, cosine);
+}
+
+/// Maps the arc tangent of the ratio min(|x|, |y|) / max(|x|, |y|) to the quadrant of (y, x)
+DISPATCH_INLINE f64 kernel_atan2_octant(f64 const result, b8 const swap, f64 const y, f64 const x) {
+    f64 const octant = swap ? PI / 2.0 - result : result;
+    f64 const quadrant = x < 0.0 ? PI - octant : octant;
+    return y < 0.0 ? -quadrant : quadrant;
+}
+
+/// Computes the four quadrant arc tangent in radians
+DISPATCH_INLINE f64 kernel_atan2(f64 const y, f64 const x) {
+    f64 const ax = x < 0.0 ? -x : x;
+    f64 const ay = y < 0.0 ? -y : y;
+    b8 const swap = ay > ax;
+    f64 const numerator = swap ? ax : ay;
+    f64 const denominator = swap ? ay : ax;
+    // Divisions are unconditional, so that they can be vectorized
+    f64 const t = numerator / (denominator > 0.0 ? denominator : 1.0);
+
+    // Reduce [0.66, 1] with atan(t) = pi/4 + atan((t - 1) / (t + 1))
+    b8 const reduce = t > 0.66;
+    f64 const reduced = (t - 1.0) / (t + 1.0);
+    f64 const u = reduce ? reduced : t;
+    f64 const z = u * u;
+
+    f64 p = -8.750608600031904122785e-1;
+    p = p * z - 1.615753718733365076637e1;
+    p = p * z - 7.500855792314704667340e1;
+    p = p * z - 1.228866684490136173410e2;
+    p = p * z - 6.485021904942025371773e1;
+
+    f64 q = z + 2.485846490142306297962e1;
+    q = q * z + 1.650270098316988542046e2;
+    q = q * z + 4.328810604912902668951e2;
+    q = q * z + 4.853903996359136964868e2;
+    q = q * z + 1.945506571482613964425e2;
+
+    f64 result = u + u * (z * p / q);
+    result += reduce ? PI / 4.0 + 3.061616997868382943065e-17 : 0.0;
+    return kernel_atan2_octant(result, swap, y, x);
+}
+
+/// Computes the four quadrant arc tangent in radians with an odd polynomial of the reduced
+/// ratio |u| <= tan(pi/8), whose coefficients c_k follow atan(u) = u + u^3 * sum c_k u^2k
+DISPATCH_INLINE f64 kernel_atan2_polynomial(f64 const y,
+                                            f64 const x,
+                                            f64 const *const coefficients,
+                                            usize const count) {
+    f64 const ax = x < 0.0 ? -x : x;
+    f64 const ay = y < 0.0 ? -y : y;
+    b8 const swap = ay > ax;
+    f64 const numerator = swap ? ax : ay;
+    f64 const denominator = swap ? ay : ax;
+    f64 const t = numerator / (denominator > 0.0 ? denominator : 1.0);
+
+    // Reduce [tan(pi/8), 1] with atan(t) = pi/4 + atan((t - 1) / (t + 1))
+    b8 const reduce = t > 0.41421356237309503;
+    f64 const reduced = (t - 1.0) / (t + 1.0);
+    f64 const u = reduce ? reduced : t;
+    f64 const z = u * u;
+
+    f64 p = coefficients[count - 1];
+    DISPATCH_UNROLL
+    for (usize i = count - 1; i > 0; --i) {
+        p = p * z + coefficients[i - 1];
+    }
+
+    f64 result = u + u * z * p;
+    result += reduce ? PI / 4.0 : 0.0;
+    return kernel_atan2_octant(result, swap, y, x);
+}
+
+/// Computes the four quadrant arc tangent in radians with an error below 6e-12
+DISPATCH_INLINE f64 kernel_atan2_high(f64 const y, f64 const x) {
+    f64 const coefficients[] = { -3.3333331689924844e-1, 1.9999849919592336e-1, -1.4280747556635795e-1,
+                                 1.1031324379860297e-1,  -8.410294981065196e-2, 4.620922833224863e-2 };
+    return kernel_atan2_polynomial(y, x, coefficients, ARRAY_SIZE(coefficients));
+}
+
+/// Computes the four quadrant arc tangent in radians with an error below 6e-9
+DISPATCH_INLINE f64 kernel_atan2_display(f64 const y, f64 const x) {
+    f64 const coefficients[] = { -3.333272681618632e-1, 1.9971036194215785e-1, -1.3817108857240873e-1,
+                                 7.882428419869197e-2 };
+    return kernel_atan2_polynomial(y, x, coefficients, ARRAY_SIZE(coefficients));
+}
+
+/// Computes sine and cosine of the angle in degrees with an error below 3e-12
+DISPATCH_INLINE void kernel_sincos_degrees_high(f64 const angle, f64 *const sine, f64 *const cosine) {
+    f64 const q = kernel_round(angle * (1.0 / 90.0));
+    f64 const r = angle - 90.0 * q;
+    kernel_sincos_quadrant_high(r * (PI / 180.0), q, sine, cosine);
+}
+
+/// Computes sine and cosine of the angle in degrees with an error below 1e-7
+DISPATCH_INLINE void kernel_sincos_degrees_display(f64 const angle, f64 *const sine, f64 *const cosine) {
+    f64 const q = kernel_round(angle * (1.0 / 90.0));
+    f64 const r = angle - 90.0 * q;
+    kernel_sincos_quadrant_display(r * (PI / 180.0), q, sine, cosine);
+}
+
+/// Computes the four quadrant arc tangent in degrees
+DISPATCH_INLINE f64 kernel_atan2_degrees(f64 const y, f64 const x) {
+    return kernel_atan2(y, x) * (180.0 / PI);
+}
+
+/// Solves kepler's equation M = E - e * sin(E) for the eccentric anomaly in radians
+/// with a fixed number of newton iterations
+DISPATCH_INLINE f64 kernel_kepler(f64 const mean_anomaly, f64 const eccentricity, usize const iterations) {
+    // Reduce to [-pi, pi] by Cody-Waite with the parts of pi/2 of kernel_sincos times four. Close to
+    // pericenter the error of the reduction is amplified by 1 / (1 - e), so 2 * PI alone is not enough.
+    f64 const turns = kernel_round(mean_anomaly * (1.0 / (2.0 * PI)));
+    f64 reduced = mean_anomaly - turns * (4.0 * 1.57079632673412561417e+00);
+    reduced -= turns * (4.0 * 6.07710050630396597660e-11);
+    reduced -= turns * (4.0 * 2.02226624871116645580e-21);
+
+    // Starter of Danby, from which newton converges for all elliptic orbits
+    f64 result = reduced + (reduced < 0.0 ? -0.85 : 0.85) * eccentricity;
+    DISPATCH_UNROLL
+    for (usize iteration = 0; iteration < iterations; ++iteration) {
+        f64 sine;
+        f64 cosine;
+        kernel_sincos(result, &sine, &cosine);
+        result -= (result - eccentricity * sine - reduced) / (1.0 - eccentricity * cosine);
+    }
+    return result + turns * (2.0 * PI);
+}
+
+#endif// SOLARIS_KERNEL_H
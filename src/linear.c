@@ -24,6 +24,9 @@
 #include <solaris/linear.h>
 #include <solaris/math.h>
 
+#include "dispatch.h"
+#include "kernel.h"
+
 /// Retrieves the length of the vector
 f64 vector3_length(Vector3 const *const vector) {
     return math_sqrt(vector->x * vector->x + vector->y * vector->y + vector->z * vector->z);
@@ -104,10 +107,28 @@ Vector3 matrix3x3_mul_vector3(Matrix3x3 const *const left, Vector3 const *const
     return result;
 }
 
+/// Multiplies the matrix with arrays of vector components in place
+void matrix3x3_mul_vector3_batch(Matrix3x3 const *const left,
+                                 f64 *const restrict x,
+                                 f64 *const restrict y,
+                                 f64 *const restrict z,
+                                 usize const count) {
+    Matrix3x3 const m = *left;
+    for (usize i = 0; i < count; ++i) {
+        f64 const rx = m.elements[0][0] * x[i] + m.elements[0][1] * y[i] + m.elements[0][2] * z[i];
+        f64 const ry = m.elements[1][0] * x[i] + m.elements[1][1] * y[i] + m.elements[1][2] * z[i];
+        f64 const rz = m.elements[2][0] * x[i] + m.elements[2][1] * y[i] + m.elements[2][2] * z[i];
+        x[i] = rx;
+        y[i] = ry;
+        z[i] = rz;
+    }
+}
+
 /// Create a new rotation matrix
 Matrix3x3 matrix3x3_rotation(RotationAxis const axis, f64 const angle) {
-    f64 const cos_angle = math_cosine(angle);
-    f64 const sin_angle = math_sine(angle);
+    f64 sin_angle;
+    f64 cos_angle;
+    math_sincos(angle, &sin_angle, &cos_angle);
     switch (axis) {
         case ROTATION_AXIS_X: {
             return (Matrix3x3) {
@@ -207,6 +228,140 @@ Equatorial equatorial_from_vector3(Vector3 const *const vector) {
     return result;
 }
 
+/// Batch kernel for the transformation of equatorial coordinates to rectangular coordinates
+DISPATCH_INLINE void vector3_from_equatorial_kernel(f64 const *const restrict right_ascension,
+                                                    f64 const *const restrict declination,
+                                                    f64 const *const restrict distance,
+                                                    f64 *const restrict x,
+                                                    f64 *const restrict y,
+                                                    f64 *const restrict z,
+                                                    usize const count) {
+    for (usize i = 0; i < count; ++i) {
+        f64 sin_right_ascension, cos_right_ascension, sin_declination, cos_declination;
+        kernel_sincos_degrees(right_ascension[i], &sin_right_ascension, &cos_right_ascension);
+        kernel_sincos_degrees(declination[i], &sin_declination, &cos_declination);
+        x[i] = cos_right_ascension * cos_declination;
+        y[i] = sin_right_ascension * cos_declination;
+        z[i] = sin_declination;
+    }
+
+    if (distance != nil) {
+        for (usize i = 0; i < count; ++i) {
+            x[i] *= distance[i];
+            y[i] *= distance[i];
+            z[i] *= distance[i];
+        }
+    }
+}
+
+/// Batch kernel for the transformation of rectangular coordinates to equatorial coordinates
+DISPATCH_INLINE void equatorial_from_vector3_kernel(f64 const *const restrict x,
+                                                    f64 const *const restrict y,
+                                                    f64 const *const restrict z,
+                                                    f64 *const restrict right_ascension,
+                                                    f64 *const restrict declination,
+                                                    f64 *const restrict distance,
+                                                    usize const count) {
+    for (usize i = 0; i < count; ++i) {
+        right_ascension[i] = kernel_atan2_degrees(y[i], x[i]);
+        declination[i] = kernel_atan2_degrees(z[i], kernel_sqrt(x[i] * x[i] + y[i] * y[i]));
+    }
+
+    if (distance != nil) {
+        for (usize i = 0; i < count; ++i) {
+            distance[i] = kernel_sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+        }
+    }
+}
+
+#if DISPATCH_X86
+DISPATCH_TARGET_AVX2 static void vector3_from_equatorial_avx2(f64 const *right_ascension,
+                                                              f64 const *declination,
+                                                              f64 const *distance,
+                                                              f64 *x,
+                                                              f64 *y,
+                                                              f64 *z,
+                                                              usize count) {
+    vector3_from_equatorial_kernel(right_ascension, declination, distance, x, y, z, count);
+}
+
+DISPATCH_TARGET_AVX512 static void vector3_from_equatorial_avx512(f64 const *right_ascension,
+                                                                  f64 const *declination,
+                                                                  f64 const *distance,
+                                                                  f64 *x,
+                                                                  f64 *y,
+                                                                  f64 *z,
+                                                                  usize count) {
+    vector3_from_equatorial_kernel(right_ascension, declination, distance, x, y, z, count);
+}
+
+DISPATCH_TARGET_AVX2 static void equatorial_from_vector3_avx2(f64 const *x,
+                                                              f64 const *y,
+                                                              f64 const *z,
+                                                              f64 *right_ascension,
+                                                              f64 *declination,
+                                                              f64 *distance,
+                                                              usize count) {
+    equatorial_from_vector3_kernel(x, y, z, right_ascension, declination, distance, count);
+}
+
+DISPATCH_TARGET_AVX512 static void equatorial_from_vector3_avx512(f64 const *x,
+                                                                  f64 const *y,
+                                                                  f64 const *z,
+                                                                  f64 *right_ascension,
+                                                                  f64 *declination,
+                                                                  f64 *distance,
+                                                                  usize count) {
+    equatorial_from_vector3_kernel(x, y, z, right_ascension, declination, distance, count);
+}
+#endif
+
+/// Transform arrays of equatorial coordinates to arrays of rectangular coordinates
+void vector3_from_equatorial_batch(f64 const *const right_ascension,
+                                   f64 const *const declination,
+                                   f64 const *const distance,
+                                   f64 *const x,
+                                   f64 *const y,
+                                   f64 *const z,
+                                   usize const count) {
+#if DISPATCH_X86
+    switch (dispatch_level()) {
+        case DISPATCH_LEVEL_AVX512:
+            vector3_from_equatorial_avx512(right_ascension, declination, distance, x, y, z, count);
+            return;
+        case DISPATCH_LEVEL_AVX2:
+            vector3_from_equatorial_avx2(right_ascension, declination, distance, x, y, z, count);
+            return;
+        case DISPATCH_LEVEL_BASELINE:
+            break;
+    }
+#endif
+    vector3_from_equatorial_kernel(right_ascension, declination, distance, x, y, z, count);
+}
+
+/// Transform arrays of rectangular coordinates to arrays of equatorial coordinates
+void equatorial_from_vector3_batch(f64 const *const x,
+                                   f64 const *const y,
+                                   f64 const *const z,
+                                   f64 *const right_ascension,
+                                   f64 *const declination,
+                                   f64 *const distance,
+                                   usize const count) {
+#if DISPATCH_X86
+    switch (dispatch_level()) {
+        case DISPATCH_LEVEL_AVX512:
+            equatorial_from_vector3_avx512(x, y, z, right_ascension, declination, distance, count);
+            return;
+        case DISPATCH_LEVEL_AVX2:
+            equatorial_from_vector3_avx2(x, y, z, right_ascension, declination, distance, count);
+            return;
+        case DISPATCH_LEVEL_BASELINE:
+            break;
+    }
+#endif
+    equatorial_from_vector3_kernel(x, y, z, right_ascension, declination, distance, count);
+}
+
 /// Transforms Equatorial coordinates to Horizontal ones
 Horizontal local_equatorial_to_horizontal(f64 const declination, f64 const hour_angle, f64 const latitude) {
     Equatorial equatorial;
@@ -234,3 +389,107 @@ Horizontal observe_geographic(Equatorial const *const equatorial,
     f64 const local_hour_angle = lmst - equatorial->right_ascension;
     return local_equatorial_to_horizontal(equatorial->declination, local_hour_angle, observer->latitude);
 }
+
+/// Transforms Equatorial coordinates to Horizontal ones with a precomputed latitude
+static Horizontal local_equatorial_to_horizontal_ctx(f64 const declination,
+                                                     f64 const hour_angle,
+                                                     ObserverContext const *const context) {
+    f64 const cos_declination = math_cosine(declination);
+    f64 const x = math_cosine(hour_angle) * cos_declination;
+    f64 const y = math_sine(hour_angle) * cos_declination;
+    f64 const z = math_sine(declination);
+
+    // Same as the rotation around the y-axis by -(90 - latitude)
+    f64 const rotated_x = context->sin_latitude * x - context->cos_latitude * z;
+    f64 const rotated_z = context->cos_latitude * x + context->sin_latitude * z;
+
+    // Add 180 to get the angle from north to east to south and so on
+    Horizontal result;
+    result.azimuth = math_arc_tangent2(y, rotated_x) + 180.0;
+    result.altitude = math_arc_sine(rotated_z);
+    return result;
+}
+
+/// Creates an observer context for the specified observer
+ObserverContext observer_context_make(Geographic const *const observer) {
+    return observer_context_make_offset(observer, time_utc_offset());
+}
+
+/// Creates an observer context for the specified observer with the explicit UTC offset
+ObserverContext observer_context_make_offset(Geographic const *const observer, s64 const utc_offset) {
+    ObserverContext result;
+    result.observer = *observer;
+    result.sin_latitude = math_sine(observer->latitude);
+    result.cos_latitude = math_cosine(observer->latitude);
+    result.utc_offset = utc_offset;
+    return result;
+}
+
+/// Computes the Horizontal position of an object at the utc mean julian day number
+static Horizontal observe_geographic_mjdn_utc(Equatorial const *const equatorial,
+                                              ObserverContext const *const context,
+                                              f64 const mjdn_utc) {
+    f64 const lmst = time_gmst_mjdn(mjdn_utc) + context->observer.longitude;
+    f64 const local_hour_angle = lmst - equatorial->right_ascension;
+    return local_equatorial_to_horizontal_ctx(equatorial->declination, local_hour_angle, context);
+}
+
+/// Computes the Horizontal position of an object with spherical coordinates
+Horizontal observe_geographic_ctx(Equatorial const *const equatorial,
+                                  ObserverContext const *const context,
+                                  Time const *const date) {
+    f64 const mjdn_utc = time_mjdn(date) - (f64) context->utc_offset / SECONDS_PER_DAY;
+    return observe_geographic_mjdn_utc(equatorial, context, mjdn_utc);
+}
+
+/// Computes the local mean sidereal time of the observer
+f64 observer_context_lmst(ObserverContext const *const context, f64 const jdn) {
+    f64 const mjdn_utc = jdn - 2400000.5 - (f64) context->utc_offset / SECONDS_PER_DAY;
+    return time_gmst_mjdn(mjdn_utc) + context->observer.longitude;
+}
+
+/// Creates a matrix that transforms rectangular equatorial coordinates
+/// with the equinox of date to the horizontal system of the observer
+Matrix3x3 matrix3x3_horizontal(ObserverContext const *const context, f64 const jdn) {
+    f64 const lmst = observer_context_lmst(context, jdn);
+    f64 const cos_lmst = math_cosine(lmst);
+    f64 const sin_lmst = math_sine(lmst);
+
+    // Right ascension to hour angle, that is a reflection as the hour angle is lmst - right ascension
+    Matrix3x3 const sidereal = {
+        .elements = { { cos_lmst, sin_lmst, 0.0 }, { sin_lmst, -cos_lmst, 0.0 }, { 0.0, 0.0, 1.0 } }
+    };
+    // Same as the rotation around the y-axis by -(90 - latitude)
+    Matrix3x3 const latitude = {
+        .elements = { { context->sin_latitude, 0.0, -context->cos_latitude },
+                      { 0.0, 1.0, 0.0 },
+                      { context->cos_latitude, 0.0, context->sin_latitude } }
+    };
+    return matrix3x3_mul(&latitude, &sidereal);
+}
+
+/// Transform a Vector3 of the horizontal system to horizontal coordinates
+Horizontal horizontal_from_vector3(Vector3 const *const vector) {
+    // Add 180 to get the angle from north to east to south and so on
+    Horizontal result;
+    result.azimuth = math_arc_tangent2(vector->y, vector->x) + 180.0;
+    result.altitude = math_arc_tangent2(vector->z, math_sqrt(vector->x * vector->x + vector->y * vector->y));
+    return result;
+}
+
+/// Computes the Horizontal position of an object with spherical coordinates
+Horizontal observe_geographic_jdn(Equatorial const *const equatorial,
+                                  ObserverContext const *const context,
+                                  f64 const jdn) {
+    f64 const local_hour_angle = observer_context_lmst(context, jdn) - equatorial->right_ascension;
+    return local_equatorial_to_horizontal_ctx(equatorial->declination, local_hour_angle, context);
+}
+
+/// Computes the Horizontal position of an object with the sidereal time of the time context
+Horizontal observe_geographic_context(Equatorial const *const equatorial,
+                                      ObserverContext const *const context,
+                                      TimeContext const *const time) {
+    f64 const lmst = time->gmst + context->observer.longitude;
+    f64 const local_hour_angle = lmst - equatorial->right_ascension;
+    return local_equatorial_to_horizontal_ctx(equatorial->declination, local_hour_angle, context);
+}
@@ -23,8 +23,55 @@
 
 #include <math.h>
 
+#if defined(_MSC_VER) && !defined(__clang__)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <stdatomic.h>
+#endif
+
 #include <solaris/math.h>
 
+#include "dispatch.h"
+#include "kernel.h"
+
+#ifndef SOLARIS_MATH_PRECISION
+#define SOLARIS_MATH_PRECISION MATH_PRECISION_FULL
+#endif
+
+/// The tier may change while workers evaluate, so it is read without ordering but atomically
+#if defined(_MSC_VER) && !defined(__clang__)
+static LONG volatile math_precision_tier = SOLARIS_MATH_PRECISION;
+
+static MathPrecision math_precision_load(void) {
+    return (MathPrecision) InterlockedCompareExchange(&math_precision_tier, 0, 0);
+}
+
+static void math_precision_store(MathPrecision const precision) {
+    InterlockedExchange(&math_precision_tier, (LONG) precision);
+}
+#else
+static _Atomic s32 math_precision_tier = SOLARIS_MATH_PRECISION;
+
+static MathPrecision math_precision_load(void) {
+    return (MathPrecision) atomic_load_explicit(&math_precision_tier, memory_order_relaxed);
+}
+
+static void math_precision_store(MathPrecision const precision) {
+    atomic_store_explicit(&math_precision_tier, (s32) precision, memory_order_relaxed);
+}
+#endif
+
+/// Selects the accuracy tier of the trigonometric functions
+void math_precision_set(MathPrecision const precision) {
+    math_precision_store(precision);
+}
+
+/// Retrieves the accuracy tier of the trigonometric functions
+MathPrecision math_precision_get(void) {
+    return math_precision_load();
+}
+
 /// Retrieves the absolute value
 f64 math_abs(f64 const x) {
     return x < 0 ? -x : x;
@@ -60,14 +107,42 @@ f64 math_modulo(f64 const a, f64 const b) {
     return fmod(a, b);
 }
 
+/// Retrieves the sine and cosine values of the specified angle at once
+void math_sincos(f64 const angle, f64 *const sine, f64 *const cosine) {
+    switch (math_precision_load()) {
+        case MATH_PRECISION_HIGH:
+            kernel_sincos_degrees_high(angle, sine, cosine);
+            return;
+        case MATH_PRECISION_DISPLAY:
+            kernel_sincos_degrees_display(angle, sine, cosine);
+            return;
+        case MATH_PRECISION_FULL:
+        default:
+            kernel_sincos_degrees(angle, sine, cosine);
+            return;
+    }
+}
+
 /// Retrieves the sine value of the specified angle
 f64 math_sine(f64 const angle) {
-    return sin(math_radians(angle));
+    if (math_precision_load() == MATH_PRECISION_FULL) {
+        return sin(math_radians(angle));
+    }
+    f64 sine;
+    f64 cosine;
+    math_sincos(angle, &sine, &cosine);
+    return sine;
 }
 
 /// Retrieves the cosine value of the specified angle
 f64 math_cosine(f64 const angle) {
-    return cos(math_radians(angle));
+    if (math_precision_load() == MATH_PRECISION_FULL) {
+        return cos(math_radians(angle));
+    }
+    f64 sine;
+    f64 cosine;
+    math_sincos(angle, &sine, &cosine);
+    return cosine;
 }
 
 /// Retrieves the tangent value of the specified angle
@@ -92,7 +167,137 @@ f64 math_arc_tangent(f64 const x) {
 
 /// Retrieves the tangent angle of the specified fraction
 f64 math_arc_tangent2(f64 const y, f64 const x) {
-    return math_degrees(atan2(y, x));
+    switch (math_precision_load()) {
+        case MATH_PRECISION_HIGH:
+            return kernel_atan2_high(y, x) * (180.0 / PI);
+        case MATH_PRECISION_DISPLAY:
+            return kernel_atan2_display(y, x) * (180.0 / PI);
+        case MATH_PRECISION_FULL:
+        default:
+            return math_degrees(atan2(y, x));
+    }
+}
+
+/// Batch kernel of sine and cosine in the accuracy tier
+DISPATCH_INLINE void math_sincos_kernel(f64 const *const restrict angle,
+                                        f64 *const restrict sine,
+                                        f64 *const restrict cosine,
+                                        usize const count,
+                                        MathPrecision const precision) {
+    switch (precision) {
+        case MATH_PRECISION_HIGH:
+            for (usize i = 0; i < count; ++i) {
+                kernel_sincos_degrees_high(angle[i], sine + i, cosine + i);
+            }
+            return;
+        case MATH_PRECISION_DISPLAY:
+            for (usize i = 0; i < count; ++i) {
+                kernel_sincos_degrees_display(angle[i], sine + i, cosine + i);
+            }
+            return;
+        case MATH_PRECISION_FULL:
+        default:
+            for (usize i = 0; i < count; ++i) {
+                kernel_sincos_degrees(angle[i], sine + i, cosine + i);
+            }
+            return;
+    }
+}
+
+/// Batch kernel of the four quadrant arc tangent in the accuracy tier
+DISPATCH_INLINE void math_arc_tangent2_kernel(f64 const *const restrict y,
+                                              f64 const *const restrict x,
+                                              f64 *const restrict angle,
+                                              usize const count,
+                                              MathPrecision const precision) {
+    switch (precision) {
+        case MATH_PRECISION_HIGH:
+            for (usize i = 0; i < count; ++i) {
+                angle[i] = kernel_atan2_high(y[i], x[i]) * (180.0 / PI);
+            }
+            return;
+        case MATH_PRECISION_DISPLAY:
+            for (usize i = 0; i < count; ++i) {
+                angle[i] = kernel_atan2_display(y[i], x[i]) * (180.0 / PI);
+            }
+            return;
+        case MATH_PRECISION_FULL:
+        default:
+            for (usize i = 0; i < count; ++i) {
+                angle[i] = kernel_atan2_degrees(y[i], x[i]);
+            }
+            return;
+    }
+}
+
+#if DISPATCH_X86
+DISPATCH_TARGET_AVX2 static void math_sincos_avx2(f64 const *angle,
+                                                  f64 *sine,
+                                                  f64 *cosine,
+                                                  usize count,
+                                                  MathPrecision precision) {
+    math_sincos_kernel(angle, sine, cosine, count, precision);
+}
+
+DISPATCH_TARGET_AVX512 static void math_sincos_avx512(f64 const *angle,
+                                                      f64 *sine,
+                                                      f64 *cosine,
+                                                      usize count,
+                                                      MathPrecision precision) {
+    math_sincos_kernel(angle, sine, cosine, count, precision);
+}
+
+DISPATCH_TARGET_AVX2 static void math_arc_tangent2_avx2(f64 const *y,
+                                                        f64 const *x,
+                                                        f64 *angle,
+                                                        usize count,
+                                                        MathPrecision precision) {
+    math_arc_tangent2_kernel(y, x, angle, count, precision);
+}
+
+DISPATCH_TARGET_AVX512 static void math_arc_tangent2_avx512(f64 const *y,
+                                                            f64 const *x,
+                                                            f64 *angle,
+                                                            usize count,
+                                                            MathPrecision precision) {
+    math_arc_tangent2_kernel(y, x, angle, count, precision);
+}
+#endif
+
+/// Retrieves the sine and cosine values of arrays of angles
+void math_sincos_batch(f64 const *const angle, f64 *const sine, f64 *const cosine, usize const count) {
+    MathPrecision const precision = math_precision_load();
+#if DISPATCH_X86
+    switch (dispatch_level()) {
+        case DISPATCH_LEVEL_AVX512:
+            math_sincos_avx512(angle, sine, cosine, count, precision);
+            return;
+        case DISPATCH_LEVEL_AVX2:
+            math_sincos_avx2(angle, sine, cosine, count, precision);
+            return;
+        case DISPATCH_LEVEL_BASELINE:
+            break;
+    }
+#endif
+    math_sincos_kernel(angle, sine, cosine, count, precision);
+}
+
+/// Retrieves the tangent angles of arrays of distances
+void math_arc_tangent2_batch(f64 const *const y, f64 const *const x, f64 *const angle, usize const count) {
+    MathPrecision const precision = math_precision_load();
+#if DISPATCH_X86
+    switch (dispatch_level()) {
+        case DISPATCH_LEVEL_AVX512:
+            math_arc_tangent2_avx512(y, x, angle, count, precision);
+            return;
+        case DISPATCH_LEVEL_AVX2:
+            math_arc_tangent2_avx2(y, x, angle, count, precision);
+            return;
+        case DISPATCH_LEVEL_BASELINE:
+            break;
+    }
+#endif
+    math_arc_tangent2_kernel(y, x, angle, count, precision);
 }
 
 /// Converts degrees, arc minutes and arc seconds to fractional degrees
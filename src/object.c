@@ -23,15 +23,39 @@
 
 #include <solaris/object.h>
 
+/// Creates the precession matrix from the catalog epoch of fixed objects to the equinox of date
+Matrix3x3 object_precession_jdn(f64 const jdn) {
+    return matrix3x3_precession(REFERENCE_PLANE_EQUATORIAL, -0.000012775, time_jc_jdn(jdn));
+}
+
 /// Computes the precessed equatorial position of the fixed object with the equinox of date
 Equatorial object_position(Object const *const body, Time const *const date_time) {
-    f64 const epoch = time_jc(date_time, false);
-    Matrix3x3 const precession = matrix3x3_precession(REFERENCE_PLANE_EQUATORIAL, -0.000012775, epoch);
+    return object_position_jdn(body, time_jdn(date_time));
+}
+
+/// Computes the precessed equatorial position of the fixed object with the equinox of date
+Equatorial object_position_jdn(Object const *const body, f64 const jdn) {
+    Matrix3x3 const precession = object_precession_jdn(jdn);
     Vector3 const position = vector3_from_equatorial(&body->position);
     Vector3 const precessed = matrix3x3_mul_vector3(&precession, &position);
     return equatorial_from_vector3(&precessed);
 }
 
+/// Computes the precessed equatorial position of the fixed object with the equinox of date with cached transforms
+Equatorial object_position_cache(Object const *const body, TransformCache *const cache, f64 const jdn) {
+    Matrix3x3 const *const precession = transform_cache_object(cache, jdn);
+    Vector3 const position = vector3_from_equatorial(&body->position);
+    Vector3 const precessed = matrix3x3_mul_vector3(precession, &position);
+    return equatorial_from_vector3(&precessed);
+}
+
+/// Computes the precessed equatorial position of the fixed object with the equinox of date with the time context
+Equatorial object_position_context(Object const *const body, TimeContext const *const time) {
+    Vector3 const position = vector3_from_equatorial(&body->position);
+    Vector3 const precessed = matrix3x3_mul_vector3(&time->object_precession, &position);
+    return equatorial_from_vector3(&precessed);
+}
+
 /// Retrieves a string representation of the provided classification
 const char *classification_string(Classification const classification) {
     switch (classification) {
@@ -23,10 +23,16 @@
 
 #include <solaris/planet.h>
 
+#include "dispatch.h"
+#include "kernel.h"
+
 /// Computes the orbital position of the planet
 Elements planet_position_orbital(Planet const *const planet, Time const *const date) {
-    f64 const t = time_jc(date, false);
+    return planet_position_orbital_jdn(planet, time_jdn(date));
+}
 
+/// Computes the orbital elements of the planet at the julian centuries since J2000
+static Elements planet_elements(Planet const *const planet, f64 const t) {
     Elements elements;
     elements.semi_major_axis = planet->state.semi_major_axis + planet->rate.semi_major_axis * t;
     elements.eccentricity = planet->state.eccentricity + planet->rate.eccentricity * t;
@@ -37,6 +43,11 @@ Elements planet_position_orbital(Planet const *const planet, Time const *const d
     return elements;
 }
 
+/// Computes the orbital position of the planet
+Elements planet_position_orbital_jdn(Planet const *const planet, f64 const jdn) {
+    return planet_elements(planet, time_jc_jdn(jdn));
+}
+
 /// Computes the eccentric anomaly using an iterative approach of kepler's equation
 f64 eccentric_anomaly(f64 const mean_anomaly, f64 const eccentricity) {
     f64 const eccentricity_degrees = math_degrees(eccentricity);
@@ -53,6 +64,52 @@ f64 eccentric_anomaly(f64 const mean_anomaly, f64 const eccentricity) {
     return result;
 }
 
+/// Batch kernel of kepler's equation
+DISPATCH_INLINE void kepler_solve_kernel(f64 const *const restrict mean_anomaly,
+                                         f64 const *const restrict eccentricity,
+                                         f64 *const restrict eccentric_anomaly,
+                                         usize const count) {
+    for (usize i = 0; i < count; ++i) {
+        eccentric_anomaly[i] = kernel_kepler(mean_anomaly[i], eccentricity[i], KEPLER_ITERATIONS);
+    }
+}
+
+#if DISPATCH_X86
+DISPATCH_TARGET_AVX2 static void kepler_solve_avx2(f64 const *mean_anomaly,
+                                                   f64 const *eccentricity,
+                                                   f64 *eccentric_anomaly,
+                                                   usize count) {
+    kepler_solve_kernel(mean_anomaly, eccentricity, eccentric_anomaly, count);
+}
+
+DISPATCH_TARGET_AVX512 static void kepler_solve_avx512(f64 const *mean_anomaly,
+                                                       f64 const *eccentricity,
+                                                       f64 *eccentric_anomaly,
+                                                       usize count) {
+    kepler_solve_kernel(mean_anomaly, eccentricity, eccentric_anomaly, count);
+}
+#endif
+
+/// Solves kepler's equation for arrays of mean anomalies and eccentricities in radians
+void kepler_solve_batch(f64 const *const mean_anomaly,
+                        f64 const *const eccentricity,
+                        f64 *const eccentric_anomaly,
+                        usize const count) {
+#if DISPATCH_X86
+    switch (dispatch_level()) {
+        case DISPATCH_LEVEL_AVX512:
+            kepler_solve_avx512(mean_anomaly, eccentricity, eccentric_anomaly, count);
+            return;
+        case DISPATCH_LEVEL_AVX2:
+            kepler_solve_avx2(mean_anomaly, eccentricity, eccentric_anomaly, count);
+            return;
+        case DISPATCH_LEVEL_BASELINE:
+            break;
+    }
+#endif
+    kepler_solve_kernel(mean_anomaly, eccentricity, eccentric_anomaly, count);
+}
+
 /// Computes the heliocentric position of the earth at the given point in time
 Vector3 position_of_earth(f64 const julian_centuries) {
     // The EM-Barycenter kepler elements are hardcoded because they are needed for every computation
@@ -79,9 +136,36 @@ Vector3 position_of_earth(f64 const julian_centuries) {
     return matrix3x3_mul_vector3(&rotation, &in_orbit);
 }
 
+/// Transforms a heliocentric ecliptic position into geocentric equatorial coordinates with the equinox of date
+static Vector3 geocentric_equatorial(Vector3 const *const helio_ecliptic, f64 const t) {
+    Vector3 const earth = position_of_earth(t);
+    Vector3 const geo_ecliptic = vector3_sub(helio_ecliptic, &earth);
+
+    Matrix3x3 const reference_transition_transform =
+            matrix3x3_reference_plane(REFERENCE_PLANE_ECLIPTIC, REFERENCE_PLANE_EQUATORIAL, 0);
+    Vector3 const geo_equatorial = matrix3x3_mul_vector3(&reference_transition_transform, &geo_ecliptic);
+
+    Matrix3x3 const precession_transform = matrix3x3_precession(REFERENCE_PLANE_EQUATORIAL, 0, t);
+    return matrix3x3_mul_vector3(&precession_transform, &geo_equatorial);
+}
+
+/// Transforms a heliocentric ecliptic position into geocentric equatorial coordinates with the fused transform
+static Vector3 geocentric_equatorial_fused(Vector3 const *const helio_ecliptic,
+                                           f64 const t,
+                                           Matrix3x3 const *const transform) {
+    Vector3 const earth = position_of_earth(t);
+    Vector3 const geo_ecliptic = vector3_sub(helio_ecliptic, &earth);
+    return matrix3x3_mul_vector3(transform, &geo_ecliptic);
+}
+
 /// Computes the equatorial position of the planet
 Equatorial planet_position_equatorial(Planet const *const planet, Time const *const date) {
-    Elements const elements = planet_position_orbital(planet, date);
+    return planet_position_equatorial_jdn(planet, time_jdn(date));
+}
+
+/// Computes the heliocentric ecliptic position of the planet
+static Vector3 planet_heliocentric_ecliptic(Planet const *const planet, f64 const t) {
+    Elements const elements = planet_elements(planet, t);
     f64 const a = elements.semi_major_axis;
     f64 const e = elements.eccentricity;
     f64 const w = elements.lon_perihelion;
@@ -110,21 +194,293 @@ Equatorial planet_position_equatorial(Planet const *const planet, Time const *co
     };
     // clang-format on
     Matrix3x3 const helio_ecliptic_transform = matrix3x3_mul_chain(chain, ARRAY_SIZE(chain));
-    Vector3 const helio_ecliptic = matrix3x3_mul_vector3(&helio_ecliptic_transform, &in_orbit);
+    return matrix3x3_mul_vector3(&helio_ecliptic_transform, &in_orbit);
+}
 
-    f64 const t = time_jc(date, false);
-    Vector3 const earth = position_of_earth(t);
-    Vector3 const geo_ecliptic = vector3_sub(&helio_ecliptic, &earth);
+/// Computes the geocentric equatorial position of the planet in cartesian coordinates
+Vector3 planet_position_vector_jdn(Planet const *const planet, f64 const jdn) {
+    f64 const t = time_jc_jdn(jdn);
+    Vector3 const helio_ecliptic = planet_heliocentric_ecliptic(planet, t);
+    return geocentric_equatorial(&helio_ecliptic, t);
+}
 
-    Matrix3x3 const reference_transition_transform =
-            matrix3x3_reference_plane(REFERENCE_PLANE_ECLIPTIC, REFERENCE_PLANE_EQUATORIAL, 0);
-    Vector3 const geo_equatorial = matrix3x3_mul_vector3(&reference_transition_transform, &geo_ecliptic);
+/// Computes the geocentric equatorial position of the planet in cartesian coordinates with cached transforms
+Vector3 planet_position_vector_cache(Planet const *const planet, TransformCache *const cache, f64 const jdn) {
+    f64 const t = time_jc_jdn(jdn);
+    Vector3 const helio_ecliptic = planet_heliocentric_ecliptic(planet, t);
+    return geocentric_equatorial_fused(&helio_ecliptic, t, transform_cache_planet(cache, jdn));
+}
 
-    Matrix3x3 const precession_transform = matrix3x3_precession(REFERENCE_PLANE_EQUATORIAL, 0, t);
-    Vector3 const geo_equatorial_precessed = matrix3x3_mul_vector3(&precession_transform, &geo_equatorial);
+/// Computes the geocentric equatorial position of the planet in cartesian coordinates with the time context
+Vector3 planet_position_vector_context(Planet const *const planet, TimeContext const *const time) {
+    Vector3 const helio_ecliptic = planet_heliocentric_ecliptic(planet, time->jc);
+    Vector3 const geo_ecliptic = vector3_sub(&helio_ecliptic, &time->earth);
+    return matrix3x3_mul_vector3(&time->planet_transform, &geo_ecliptic);
+}
+
+/// Computes the equatorial position of the planet with the time context
+Equatorial planet_position_equatorial_context(Planet const *const planet, TimeContext const *const time) {
+    Vector3 const geo_equatorial_precessed = planet_position_vector_context(planet, time);
+    return equatorial_from_vector3(&geo_equatorial_precessed);
+}
+
+/// Computes the equatorial position of the planet with cached transforms
+Equatorial planet_position_equatorial_cache(Planet const *const planet, TransformCache *const cache, f64 const jdn) {
+    Vector3 const geo_equatorial_precessed = planet_position_vector_cache(planet, cache, jdn);
+    return equatorial_from_vector3(&geo_equatorial_precessed);
+}
+
+/// Computes the equatorial position of the planet
+Equatorial planet_position_equatorial_jdn(Planet const *const planet, f64 const jdn) {
+    Vector3 const geo_equatorial_precessed = planet_position_vector_jdn(planet, jdn);
     return equatorial_from_vector3(&geo_equatorial_precessed);
 }
 
+/// Computes the geocentric equatorial position of the sun in cartesian coordinates
+Vector3 sun_position_vector_jdn(f64 const jdn) {
+    Vector3 const sun = { 0.0, 0.0, 0.0 };
+    return geocentric_equatorial(&sun, time_jc_jdn(jdn));
+}
+
+/// Computes the geocentric equatorial position of the sun in cartesian coordinates with cached transforms
+Vector3 sun_position_vector_cache(TransformCache *const cache, f64 const jdn) {
+    Vector3 const sun = { 0.0, 0.0, 0.0 };
+    return geocentric_equatorial_fused(&sun, time_jc_jdn(jdn), transform_cache_planet(cache, jdn));
+}
+
+/// Computes the equatorial position of the sun
+Equatorial sun_position_equatorial_jdn(f64 const jdn) {
+    Vector3 const sun = sun_position_vector_jdn(jdn);
+    return equatorial_from_vector3(&sun);
+}
+
+/// Computes the geocentric equatorial position of the sun in cartesian coordinates with the time context
+Vector3 sun_position_vector_context(TimeContext const *const time) {
+    Vector3 const sun = { 0.0, 0.0, 0.0 };
+    Vector3 const geo_ecliptic = vector3_sub(&sun, &time->earth);
+    return matrix3x3_mul_vector3(&time->planet_transform, &geo_ecliptic);
+}
+
+/// Computes the equatorial position of the sun with the time context
+Equatorial sun_position_equatorial_context(TimeContext const *const time) {
+    Vector3 const sun = sun_position_vector_context(time);
+    return equatorial_from_vector3(&sun);
+}
+
+/// Number of lanes of a planet batch, the earth occupies one lane per step
+#define PLANET_BATCH_LANES 64
+
+/// Fixed number of newton iterations of kepler's equation in a planet batch,
+/// which converges to double precision for eccentricities up to 0.3
+#define PLANET_BATCH_ITERATIONS 4
+
+/// The EM-Barycenter as planet, which is evaluated in the same lanes as the planets
+static Planet const planet_earth_barycenter = {
+    .name = PLANET_EARTH,
+    .state = { .semi_major_axis = 1.00000261,
+               .eccentricity = 0.01671022,
+               .inclination = 0.0,
+               .mean_longitude = 100.46457166,
+               .lon_perihelion = 102.93768193,
+               .lon_asc_node = 0.0 },
+    .rate = { .semi_major_axis = 0.00000562,
+              .eccentricity = -0.00003804,
+              .inclination = 0.0,
+              .mean_longitude = 35999.37244981,
+              .lon_perihelion = 0.32327364,
+              .lon_asc_node = 0.0 }
+};
+
+/// Structure-of-arrays view of the orbital elements and the resulting positions of a batch
+typedef struct PlanetLanes {
+    f64 semi_major_axis[PLANET_BATCH_LANES];
+    f64 eccentricity[PLANET_BATCH_LANES];
+    f64 inclination[PLANET_BATCH_LANES];
+    f64 mean_longitude[PLANET_BATCH_LANES];
+    f64 lon_perihelion[PLANET_BATCH_LANES];
+    f64 lon_asc_node[PLANET_BATCH_LANES];
+    f64 x[PLANET_BATCH_LANES];
+    f64 y[PLANET_BATCH_LANES];
+    f64 z[PLANET_BATCH_LANES];
+} PlanetLanes;
+
+/// Evaluates the orbital elements of the planet into the lane
+static void planet_lanes_fill(PlanetLanes *const lanes, usize const lane, Planet const *const planet, f64 const t) {
+    lanes->semi_major_axis[lane] = planet->state.semi_major_axis + planet->rate.semi_major_axis * t;
+    lanes->eccentricity[lane] = planet->state.eccentricity + planet->rate.eccentricity * t;
+    lanes->inclination[lane] = planet->state.inclination + planet->rate.inclination * t;
+    lanes->mean_longitude[lane] = planet->state.mean_longitude + planet->rate.mean_longitude * t;
+    lanes->lon_perihelion[lane] = planet->state.lon_perihelion + planet->rate.lon_perihelion * t;
+    lanes->lon_asc_node[lane] = planet->state.lon_asc_node + planet->rate.lon_asc_node * t;
+}
+
+/// Batch kernel for the heliocentric ecliptic positions of the lanes
+DISPATCH_INLINE void planet_heliocentric_kernel(PlanetLanes *const restrict lanes, usize const count) {
+    for (usize i = 0; i < count; ++i) {
+        f64 const a = lanes->semi_major_axis[i];
+        f64 const e = lanes->eccentricity[i];
+        f64 const w = lanes->lon_perihelion[i];
+        f64 const Om = lanes->lon_asc_node[i];
+
+        // eccentric anomaly with a fixed number of newton iterations, so that all lanes take the same path
+        f64 const mean_anomaly = (lanes->mean_longitude[i] - w) * (PI / 180.0);
+        f64 const ecc_anomaly = kernel_kepler(mean_anomaly, e, PLANET_BATCH_ITERATIONS);
+        f64 sin_ecc;
+        f64 cos_ecc;
+        kernel_sincos(ecc_anomaly, &sin_ecc, &cos_ecc);
+
+        f64 const orbit_x = a * (cos_ecc - e);
+        f64 const orbit_y = a * kernel_sqrt(1.0 - e * e) * sin_ecc;
+
+        // expanded rotation chain Rz(Om) * Rx(I) * Rz(w - Om)
+        f64 sin_perihelion;
+        f64 cos_perihelion;
+        f64 sin_inclination;
+        f64 cos_inclination;
+        f64 sin_node;
+        f64 cos_node;
+        kernel_sincos_degrees(w - Om, &sin_perihelion, &cos_perihelion);
+        kernel_sincos_degrees(lanes->inclination[i], &sin_inclination, &cos_inclination);
+        kernel_sincos_degrees(Om, &sin_node, &cos_node);
+
+        f64 const p = orbit_x * cos_perihelion - orbit_y * sin_perihelion;
+        f64 const r = orbit_x * sin_perihelion + orbit_y * cos_perihelion;
+        f64 const q = r * cos_inclination;
+        lanes->x[i] = p * cos_node - q * sin_node;
+        lanes->y[i] = p * sin_node + q * cos_node;
+        lanes->z[i] = r * sin_inclination;
+    }
+}
+
+#if DISPATCH_X86
+DISPATCH_TARGET_AVX2 static void planet_heliocentric_avx2(PlanetLanes *lanes, usize count) {
+    planet_heliocentric_kernel(lanes, count);
+}
+
+DISPATCH_TARGET_AVX512 static void planet_heliocentric_avx512(PlanetLanes *lanes, usize count) {
+    planet_heliocentric_kernel(lanes, count);
+}
+#endif
+
+/// Computes the heliocentric ecliptic positions of the lanes
+static void planet_heliocentric_batch(PlanetLanes *const lanes, usize const count) {
+#if DISPATCH_X86
+    switch (dispatch_level()) {
+        case DISPATCH_LEVEL_AVX512:
+            planet_heliocentric_avx512(lanes, count);
+            return;
+        case DISPATCH_LEVEL_AVX2:
+            planet_heliocentric_avx2(lanes, count);
+            return;
+        case DISPATCH_LEVEL_BASELINE:
+            break;
+    }
+#endif
+    planet_heliocentric_kernel(lanes, count);
+}
+
+/// Computes the geocentric equatorial positions of the planets along the series of julian day numbers,
+/// either as vectors or as equatorial coordinates
+static void planet_positions_series(Planet const *const planets,
+                                    usize const count,
+                                    f64 const start,
+                                    f64 const step,
+                                    usize const steps,
+                                    Vector3 *const vectors,
+                                    Equatorial *const equatorials) {
+    PlanetLanes lanes;
+    f64 right_ascensions[PLANET_BATCH_LANES];
+    f64 declinations[PLANET_BATCH_LANES];
+    f64 distances[PLANET_BATCH_LANES];
+
+    // Every step of a batch holds the earth followed by a block of planets
+    usize const block_size = count < PLANET_BATCH_LANES - 1 ? count : PLANET_BATCH_LANES - 1;
+    for (usize block = 0; block < count; block += block_size) {
+        usize const bodies = count - block < block_size ? count - block : block_size;
+        usize const stride = bodies + 1;
+        usize const batch_steps = PLANET_BATCH_LANES / stride;
+
+        for (usize first = 0; first < steps; first += batch_steps) {
+            usize const active = steps - first < batch_steps ? steps - first : batch_steps;
+            for (usize index = 0; index < active; ++index) {
+                f64 const t = time_jc_jdn(start + (f64) (first + index) * step);
+                planet_lanes_fill(&lanes, index * stride, &planet_earth_barycenter, t);
+                for (usize body = 0; body < bodies; ++body) {
+                    planet_lanes_fill(&lanes, index * stride + 1 + body, planets + block + body, t);
+                }
+            }
+            planet_heliocentric_batch(&lanes, active * stride);
+
+            // The frame and precession transform is shared by the planets of a step
+            TransformCache cache = transform_cache_make(0.0);
+            for (usize index = 0; index < active; ++index) {
+                Matrix3x3 const *const transform = transform_cache_planet(&cache, start + (f64) (first + index) * step);
+                usize const earth = index * stride;
+                for (usize lane = earth + 1; lane < earth + stride; ++lane) {
+                    Vector3 const geo_ecliptic = { lanes.x[lane] - lanes.x[earth],
+                                                   lanes.y[lane] - lanes.y[earth],
+                                                   lanes.z[lane] - lanes.z[earth] };
+                    Vector3 const geo_equatorial = matrix3x3_mul_vector3(transform, &geo_ecliptic);
+                    lanes.x[lane] = geo_equatorial.x;
+                    lanes.y[lane] = geo_equatorial.y;
+                    lanes.z[lane] = geo_equatorial.z;
+                }
+            }
+
+            if (equatorials != nil) {
+                equatorial_from_vector3_batch(lanes.x,
+                                              lanes.y,
+                                              lanes.z,
+                                              right_ascensions,
+                                              declinations,
+                                              distances,
+                                              active * stride);
+            }
+
+            for (usize index = 0; index < active; ++index) {
+                for (usize body = 0; body < bodies; ++body) {
+                    usize const lane = index * stride + 1 + body;
+                    usize const target = (first + index) * count + block + body;
+                    if (vectors != nil) {
+                        vectors[target] = (Vector3) { lanes.x[lane], lanes.y[lane], lanes.z[lane] };
+                    }
+                    if (equatorials != nil) {
+                        equatorials[target] = (Equatorial) { .right_ascension = right_ascensions[lane],
+                                                             .declination = declinations[lane],
+                                                             .distance = distances[lane] };
+                    }
+                }
+            }
+        }
+    }
+}
+
+/// Computes the geocentric equatorial positions of the planets in cartesian coordinates
+void planet_positions_vector_jdn(Planet const *const planets,
+                                 usize const count,
+                                 f64 const jdn,
+                                 Vector3 *const positions) {
+    planet_positions_series(planets, count, jdn, 0.0, 1, positions, nil);
+}
+
+/// Computes the equatorial positions of the planets
+void planet_positions_equatorial_jdn(Planet const *const planets,
+                                     usize const count,
+                                     f64 const jdn,
+                                     Equatorial *const positions) {
+    planet_positions_series(planets, count, jdn, 0.0, 1, nil, positions);
+}
+
+/// Computes the equatorial positions of the planets along a series of julian day numbers
+void planet_positions_equatorial_series(Planet const *const planets,
+                                        usize const count,
+                                        f64 const start,
+                                        f64 const step,
+                                        usize const steps,
+                                        Equatorial *const positions) {
+    planet_positions_series(planets, count, start, step, steps, nil, positions);
+}
+
 /// Retrieves the name of the planet in string representation
 const char *planet_string(PlanetName const name) {
     switch (name) {
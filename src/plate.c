@@ -0,0 +1,584 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Elias Engelbert Plank
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <solaris/math.h>
+#include <solaris/plate.h>
+
+enum {
+    PLATE_NEIGHBOURS = 8,
+    PLATE_BINS = 64,
+    PLATE_STARS = 12,
+    PLATE_MIN_MATCHES = 5,
+};
+
+/// Largest deviation of the side ratios of matching triangles
+static f64 const PLATE_RATIO_TOLERANCE = 0.01;
+
+/// Smallest ratio of the shortest to the longest side and smallest relative difference
+/// of two sides, flatter and nearly isosceles triangles have no stable vertex order
+static f64 const PLATE_MIN_RATIO = 0.1;
+static f64 const PLATE_MIN_DIFFERENCE = 0.02;
+
+/// Default match tolerance in pixels
+static f64 const PLATE_TOLERANCE = 2.0;
+
+static f64 const PLATE_ARCSECONDS_PER_RADIAN = 206264.80624709636;
+
+/// Tangent plane of the gnomonic projection, east and north span the plane
+typedef struct PlatePlane {
+    Vector3 center;
+    Vector3 east;
+    Vector3 north;
+} PlatePlane;
+
+/// Similarity transform from pixels to the tangent plane, w = a * z + b as complex
+/// numbers, where z is the conjugated pixel position if the image is flipped
+typedef struct PlateTransform {
+    f64 a_re;
+    f64 a_im;
+    f64 b_re;
+    f64 b_im;
+    b8 flipped;
+} PlateTransform;
+
+/// Triangle whose vertices are ordered by the length of the opposite side
+typedef struct PlateTriangle {
+    u32 vertices[3];
+    f64 ratios[2];
+    usize bin;
+} PlateTriangle;
+
+/// Catalog object that is matched with a star
+typedef struct PlateMatch {
+    usize object;
+    usize star;
+} PlateMatch;
+
+/// Dot product of the two vectors
+static f64 plate_dot(Vector3 const *const a, Vector3 const *const b) {
+    return a->x * b->x + a->y * b->y + a->z * b->z;
+}
+
+/// Normalizes the vector
+static Vector3 plate_normalize(Vector3 const *const vector) {
+    f64 const length = vector3_length(vector);
+    return (Vector3) { .x = vector->x / length, .y = vector->y / length, .z = vector->z / length };
+}
+
+/// Retrieves the unit vector of the object of the index
+static Vector3 plate_object(PlateIndex const *const index, usize const object) {
+    return (Vector3) { .x = index->x[object], .y = index->y[object], .z = index->z[object] };
+}
+
+/// Creates the tangent plane at the specified point
+static PlatePlane plate_plane_make(Vector3 const *const center) {
+    PlatePlane plane;
+    plane.center = plate_normalize(center);
+
+    // East is perpendicular to the pole and the center, close to the pole any direction works
+    Vector3 east = { -plane.center.y, plane.center.x, 0.0 };
+    if (vector3_length(&east) < 1.0e-12) {
+        east = (Vector3) { 0.0, 1.0, 0.0 };
+    }
+    plane.east = plate_normalize(&east);
+    plane.north = (Vector3) { plane.center.y * plane.east.z - plane.center.z * plane.east.y,
+                              plane.center.z * plane.east.x - plane.center.x * plane.east.z,
+                              plane.center.x * plane.east.y - plane.center.y * plane.east.x };
+    return plane;
+}
+
+/// Projects the point onto the tangent plane, points of the other hemisphere cannot be projected
+static b8 plate_plane_project(PlatePlane const *const plane,
+                              Vector3 const *const point,
+                              f64 *const xi,
+                              f64 *const eta) {
+    f64 const height = plate_dot(&plane->center, point);
+    if (height <= 0.0) {
+        return false;
+    }
+    *xi = plate_dot(&plane->east, point) / height;
+    *eta = plate_dot(&plane->north, point) / height;
+    return true;
+}
+
+/// Retrieves the point on the sphere of the position on the tangent plane
+static Vector3 plate_plane_deproject(PlatePlane const *const plane, f64 const xi, f64 const eta) {
+    Vector3 const point = { plane->center.x + xi * plane->east.x + eta * plane->north.x,
+                            plane->center.y + xi * plane->east.y + eta * plane->north.y,
+                            plane->center.z + xi * plane->east.z + eta * plane->north.z };
+    return plate_normalize(&point);
+}
+
+/// Maps the pixel onto the tangent plane
+static void plate_transform_apply(PlateTransform const *const transform,
+                                  f64 const x,
+                                  f64 const y,
+                                  f64 *const xi,
+                                  f64 *const eta) {
+    f64 const im = transform->flipped ? -y : y;
+    *xi = transform->a_re * x - transform->a_im * im + transform->b_re;
+    *eta = transform->a_re * im + transform->a_im * x + transform->b_im;
+}
+
+/// Maps the position of the tangent plane to the pixel
+static void plate_transform_invert(PlateTransform const *const transform,
+                                   f64 const xi,
+                                   f64 const eta,
+                                   f64 *const x,
+                                   f64 *const y) {
+    f64 const re = xi - transform->b_re;
+    f64 const im = eta - transform->b_im;
+    f64 const norm = transform->a_re * transform->a_re + transform->a_im * transform->a_im;
+    *x = (re * transform->a_re + im * transform->a_im) / norm;
+    f64 const y_conjugate = (im * transform->a_re - re * transform->a_im) / norm;
+    *y = transform->flipped ? -y_conjugate : y_conjugate;
+}
+
+/// Fits the similarity transform to the pixels and tangent plane positions with least squares
+static void plate_transform_fit(PlateTransform *const transform,
+                                f64 const *const x,
+                                f64 const *const y,
+                                f64 const *const xi,
+                                f64 const *const eta,
+                                usize const count,
+                                b8 const flipped) {
+    f64 mean_x = 0.0;
+    f64 mean_y = 0.0;
+    f64 mean_xi = 0.0;
+    f64 mean_eta = 0.0;
+    for (usize i = 0; i < count; ++i) {
+        mean_x += x[i];
+        mean_y += flipped ? -y[i] : y[i];
+        mean_xi += xi[i];
+        mean_eta += eta[i];
+    }
+    mean_x /= (f64) count;
+    mean_y /= (f64) count;
+    mean_xi /= (f64) count;
+    mean_eta /= (f64) count;
+
+    // a = sum(w * conj(z)) / sum(|z|^2) of the centered positions
+    f64 numerator_re = 0.0;
+    f64 numerator_im = 0.0;
+    f64 denominator = 0.0;
+    for (usize i = 0; i < count; ++i) {
+        f64 const zx = x[i] - mean_x;
+        f64 const zy = (flipped ? -y[i] : y[i]) - mean_y;
+        f64 const wx = xi[i] - mean_xi;
+        f64 const wy = eta[i] - mean_eta;
+        numerator_re += wx * zx + wy * zy;
+        numerator_im += wy * zx - wx * zy;
+        denominator += zx * zx + zy * zy;
+    }
+    transform->a_re = numerator_re / denominator;
+    transform->a_im = numerator_im / denominator;
+    transform->b_re = mean_xi - (transform->a_re * mean_x - transform->a_im * mean_y);
+    transform->b_im = mean_eta - (transform->a_re * mean_y + transform->a_im * mean_x);
+    transform->flipped = flipped;
+}
+
+/// Orders the vertices by the length of the opposite side and computes the side ratios
+static b8 plate_triangle_order(f64 const *const sides, usize *const order, f64 *const ratios) {
+    order[0] = 0;
+    order[1] = 1;
+    order[2] = 2;
+    for (usize i = 0; i < 3; ++i) {
+        for (usize j = i + 1; j < 3; ++j) {
+            if (sides[order[j]] < sides[order[i]]) {
+                usize const swap = order[i];
+                order[i] = order[j];
+                order[j] = swap;
+            }
+        }
+    }
+
+    f64 const longest = sides[order[2]];
+    if (longest <= 0.0) {
+        return false;
+    }
+    ratios[0] = sides[order[0]] / longest;
+    ratios[1] = sides[order[1]] / longest;
+    return ratios[0] >= PLATE_MIN_RATIO && ratios[1] - ratios[0] >= PLATE_MIN_DIFFERENCE &&
+           1.0 - ratios[1] >= PLATE_MIN_DIFFERENCE;
+}
+
+/// Retrieves the hash bin of the coordinates of the bin
+static usize plate_bin(f64 const first, f64 const second) {
+    usize const i = (usize) (first * PLATE_BINS) < PLATE_BINS - 1 ? (usize) (first * PLATE_BINS) : PLATE_BINS - 1;
+    usize const j = (usize) (second * PLATE_BINS) < PLATE_BINS - 1 ? (usize) (second * PLATE_BINS) : PLATE_BINS - 1;
+    return i * PLATE_BINS + j;
+}
+
+/// Creates the plate solving index of the catalog objects
+void plate_index_make(MemoryArena *arena, PlateIndex *const index, Catalog const *const catalog, usize neighbours) {
+    neighbours = neighbours > 1 ? neighbours : PLATE_NEIGHBOURS;
+    usize const count = catalog->object_count;
+    spatial_index_make(arena, &index->spatial, catalog, 0);
+
+    index->object_count = count;
+    index->x = (f64 *) memory_arena_alloc(arena, count * sizeof(f64));
+    index->y = (f64 *) memory_arena_alloc(arena, count * sizeof(f64));
+    index->z = (f64 *) memory_arena_alloc(arena, count * sizeof(f64));
+    for (usize slot = 0; slot < count; ++slot) {
+        index->x[index->spatial.indices[slot]] = index->spatial.x[slot];
+        index->y[index->spatial.indices[slot]] = index->spatial.y[slot];
+        index->z[index->spatial.indices[slot]] = index->spatial.z[slot];
+    }
+
+    // Only degenerate triangles are dropped, so the index is sized by the amount of candidates
+    usize const bins = PLATE_BINS * PLATE_BINS;
+    usize const capacity = count * neighbours * (neighbours - 1) / 2;
+    index->offsets = (u32 *) memory_arena_alloc(arena, (bins + 1) * sizeof(u32));
+    index->triangles = (u32 *) memory_arena_alloc(arena, 3 * capacity * sizeof(u32));
+    index->ratios = (f64 *) memory_arena_alloc(arena, 2 * capacity * sizeof(f64));
+
+    // Triangles of every object with pairs of its nearest neighbours, released once they are sorted
+    MemoryArenaMark const mark = memory_arena_mark(arena);
+    PlateTriangle *const triangles = (PlateTriangle *) memory_arena_alloc(arena, capacity * sizeof(PlateTriangle));
+    usize triangle_count = 0;
+    for (usize object = 0; object < count; ++object) {
+        Vector3 const center = plate_object(index, object);
+        Equatorial const position = equatorial_from_vector3(&center);
+        MemoryArenaMark const object_mark = memory_arena_mark(arena);
+        SpatialResult nearest;
+        spatial_index_nearest(arena, &nearest, &index->spatial, &position, neighbours + 1);
+
+        for (usize i = 0; i < nearest.count; ++i) {
+            for (usize j = i + 1; j < nearest.count; ++j) {
+                if (nearest.indices[i] == object || nearest.indices[j] == object) {
+                    continue;
+                }
+                u32 const vertices[] = { (u32) object, (u32) nearest.indices[i], (u32) nearest.indices[j] };
+                Vector3 points[3];
+                for (usize k = 0; k < 3; ++k) {
+                    points[k] = plate_object(index, vertices[k]);
+                }
+                f64 sides[3];
+                for (usize k = 0; k < 3; ++k) {
+                    Vector3 const side = vector3_sub(points + (k + 1) % 3, points + (k + 2) % 3);
+                    sides[k] = vector3_length(&side);
+                }
+
+                usize order[3];
+                PlateTriangle *const triangle = triangles + triangle_count;
+                if (triangle_count < capacity && plate_triangle_order(sides, order, triangle->ratios)) {
+                    for (usize k = 0; k < 3; ++k) {
+                        triangle->vertices[k] = vertices[order[k]];
+                    }
+                    triangle->bin = plate_bin(triangle->ratios[0], triangle->ratios[1]);
+                    triangle_count++;
+                }
+            }
+        }
+        memory_arena_rewind(arena, object_mark);
+    }
+
+    // Counting sort by hash bin, offsets are shifted by one while placing the triangles
+    index->triangle_count = triangle_count;
+    for (usize i = 0; i <= bins; ++i) {
+        index->offsets[i] = 0;
+    }
+    for (usize i = 0; i < triangle_count; ++i) {
+        ++index->offsets[triangles[i].bin + 1];
+    }
+    for (usize i = 1; i <= bins; ++i) {
+        index->offsets[i] += index->offsets[i - 1];
+    }
+    for (usize i = 0; i < triangle_count; ++i) {
+        u32 const slot = index->offsets[triangles[i].bin]++;
+        for (usize k = 0; k < 3; ++k) {
+            index->triangles[3 * slot + k] = triangles[i].vertices[k];
+        }
+        index->ratios[2 * slot] = triangles[i].ratios[0];
+        index->ratios[2 * slot + 1] = triangles[i].ratios[1];
+    }
+    for (usize i = bins; i > 0; --i) {
+        index->offsets[i] = index->offsets[i - 1];
+    }
+    index->offsets[0] = 0;
+    memory_arena_rewind(arena, mark);
+}
+
+/// Projects the catalog objects of the field onto the image and matches them with the stars
+static usize plate_verify(MemoryArena *scratch,
+                          PlateIndex const *const index,
+                          PlatePlane const *const plane,
+                          PlateTransform const *const transform,
+                          PlateStar const *const stars,
+                          usize const star_count,
+                          PlateSpecification const *const spec,
+                          f64 const tolerance,
+                          PlateMatch *const matches) {
+    f64 xi;
+    f64 eta;
+    plate_transform_apply(transform, 0.5 * spec->width, 0.5 * spec->height, &xi, &eta);
+    Vector3 const center = plate_plane_deproject(plane, xi, eta);
+
+    // The cone around the image center with a margin contains the whole image
+    f64 const scale = math_sqrt(transform->a_re * transform->a_re + transform->a_im * transform->a_im);
+    f64 const diagonal = math_sqrt(spec->width * spec->width + spec->height * spec->height);
+    f64 const radius = math_degrees(0.55 * scale * diagonal);
+
+    Equatorial const position = equatorial_from_vector3(&center);
+    SpatialResult field;
+    spatial_index_cone(scratch, &field, &index->spatial, &position, radius);
+
+    b8 *const matched = (b8 *) memory_arena_alloc(scratch, star_count * sizeof(b8));
+    for (usize i = 0; i < star_count; ++i) {
+        matched[i] = false;
+    }
+
+    usize count = 0;
+    f64 const limit = tolerance * tolerance;
+    for (usize i = 0; i < field.count; ++i) {
+        Vector3 const point = plate_object(index, field.indices[i]);
+        f64 x;
+        f64 y;
+        if (!plate_plane_project(plane, &point, &xi, &eta)) {
+            continue;
+        }
+        plate_transform_invert(transform, xi, eta, &x, &y);
+        if (x < -tolerance || y < -tolerance || x > spec->width + tolerance || y > spec->height + tolerance) {
+            continue;
+        }
+
+        usize best = star_count;
+        f64 best_distance = limit;
+        for (usize star = 0; star < star_count; ++star) {
+            f64 const dx = stars[star].x - x;
+            f64 const dy = stars[star].y - y;
+            f64 const distance = dx * dx + dy * dy;
+            if (!matched[star] && distance <= best_distance) {
+                best = star;
+                best_distance = distance;
+            }
+        }
+        if (best < star_count) {
+            matched[best] = true;
+            matches[count].object = field.indices[i];
+            matches[count].star = best;
+            count++;
+        }
+    }
+    return count;
+}
+
+/// Refits the transform with all matched stars at the image center and matches the stars again
+static usize plate_refine(MemoryArena *scratch,
+                          PlateIndex const *const index,
+                          PlatePlane *const plane,
+                          PlateTransform *const transform,
+                          PlateStar const *const stars,
+                          usize const star_count,
+                          PlateSpecification const *const spec,
+                          f64 const tolerance,
+                          PlateMatch *const matches,
+                          usize match_count) {
+    f64 *const x = (f64 *) memory_arena_alloc(scratch, star_count * sizeof(f64));
+    f64 *const y = (f64 *) memory_arena_alloc(scratch, star_count * sizeof(f64));
+    f64 *const xi = (f64 *) memory_arena_alloc(scratch, star_count * sizeof(f64));
+    f64 *const eta = (f64 *) memory_arena_alloc(scratch, star_count * sizeof(f64));
+    f64 const half_width = 0.5 * spec->width;
+    f64 const half_height = transform->flipped ? -0.5 * spec->height : 0.5 * spec->height;
+
+    // The tangent point moves to the image center, where the projection is the most accurate
+    for (usize iteration = 0; iteration < 3; ++iteration) {
+        f64 center_xi;
+        f64 center_eta;
+        plate_transform_apply(transform, 0.5 * spec->width, 0.5 * spec->height, &center_xi, &center_eta);
+        Vector3 const center = plate_plane_deproject(plane, center_xi, center_eta);
+        *plane = plate_plane_make(&center);
+
+        usize count = 0;
+        for (usize i = 0; i < match_count; ++i) {
+            Vector3 const point = plate_object(index, matches[i].object);
+            if (plate_plane_project(plane, &point, xi + count, eta + count)) {
+                x[count] = stars[matches[i].star].x - 0.5 * spec->width;
+                y[count] = stars[matches[i].star].y - 0.5 * spec->height;
+                count++;
+            }
+        }
+        plate_transform_fit(transform, x, y, xi, eta, count, transform->flipped);
+
+        // The fit is relative to the image center, so the pixels are shifted back
+        transform->b_re -= transform->a_re * half_width - transform->a_im * half_height;
+        transform->b_im -= transform->a_re * half_height + transform->a_im * half_width;
+
+        match_count = plate_verify(scratch, index, plane, transform, stars, star_count, spec, tolerance, matches);
+    }
+    return match_count;
+}
+
+/// Verifies the candidate triangle of the index with the stars and refines the solution
+static b8 plate_candidate(MemoryArena *scratch,
+                          PlateIndex const *const index,
+                          u32 const slot,
+                          f64 const *const x,
+                          f64 const *const y,
+                          PlateStar const *const stars,
+                          usize const star_count,
+                          PlateSpecification const *const spec,
+                          f64 const tolerance,
+                          PlateMatch *const matches,
+                          PlateSolution *const solution) {
+    Vector3 points[3];
+    Vector3 centroid = { 0.0, 0.0, 0.0 };
+    for (usize c = 0; c < 3; ++c) {
+        points[c] = plate_object(index, index->triangles[3 * slot + c]);
+        centroid = vector3_add(&centroid, points + c);
+    }
+    PlatePlane plane = plate_plane_make(&centroid);
+    f64 xi[3];
+    f64 eta[3];
+    for (usize c = 0; c < 3; ++c) {
+        if (!plate_plane_project(&plane, points + c, xi + c, eta + c)) {
+            return false;
+        }
+    }
+
+    // Opposite orientations of the triangles mean that the image is mirrored
+    f64 const image_area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+    f64 const sky_area = (xi[1] - xi[0]) * (eta[2] - eta[0]) - (eta[1] - eta[0]) * (xi[2] - xi[0]);
+    PlateTransform transform;
+    plate_transform_fit(&transform, x, y, xi, eta, 3, (image_area > 0.0) != (sky_area > 0.0));
+
+    f64 const scale = math_sqrt(transform.a_re * transform.a_re + transform.a_im * transform.a_im) *
+                      PLATE_ARCSECONDS_PER_RADIAN;
+    if ((spec->scale_min > 0.0 && scale < spec->scale_min) || (spec->scale_max > 0.0 && scale > spec->scale_max)) {
+        return false;
+    }
+
+    usize match_count = plate_verify(scratch, index, &plane, &transform, stars, star_count, spec, tolerance, matches);
+    if (match_count < PLATE_MIN_MATCHES) {
+        return false;
+    }
+    match_count =
+            plate_refine(scratch, index, &plane, &transform, stars, star_count, spec, tolerance, matches, match_count);
+    if (match_count < PLATE_MIN_MATCHES) {
+        return false;
+    }
+
+    f64 center_xi;
+    f64 center_eta;
+    plate_transform_apply(&transform, 0.5 * spec->width, 0.5 * spec->height, &center_xi, &center_eta);
+    Vector3 const center = plate_plane_deproject(&plane, center_xi, center_eta);
+
+    solution->center = equatorial_from_vector3(&center);
+    solution->center.right_ascension = math_modulo(solution->center.right_ascension + 360.0, 360.0);
+    solution->center.distance = 1.0;
+    solution->rotation = math_arc_tangent2(transform.a_im, transform.a_re);
+    solution->scale = math_sqrt(transform.a_re * transform.a_re + transform.a_im * transform.a_im) *
+                      PLATE_ARCSECONDS_PER_RADIAN;
+    solution->center_x = 0.5 * spec->width;
+    solution->center_y = 0.5 * spec->height;
+    solution->matches = match_count;
+    solution->flipped = transform.flipped;
+    solution->solved = true;
+    return true;
+}
+
+/// Solves the plate from the detected stars without prior position
+PlateSolution plate_solve(MemoryArena *arena,
+                          PlateIndex const *const index,
+                          PlateStar const *const stars,
+                          usize const star_count,
+                          PlateSpecification const *const spec) {
+    PlateSolution solution = { 0 };
+    usize const limit = spec->stars > 0 ? spec->stars : PLATE_STARS;
+    usize const brightest = star_count < limit ? star_count : limit;
+    f64 const tolerance = spec->tolerance > 0.0 ? spec->tolerance : PLATE_TOLERANCE;
+
+    // The matches and the scratch of the candidates are released before returning
+    MemoryArenaMark const mark = memory_arena_mark(arena);
+    PlateMatch *const matches = (PlateMatch *) memory_arena_alloc(arena, star_count * sizeof(PlateMatch));
+    MemoryArenaMark const candidate_mark = memory_arena_mark(arena);
+
+    for (usize k = 2; k < brightest && !solution.solved; ++k) {
+        for (usize j = 1; j < k && !solution.solved; ++j) {
+            for (usize i = 0; i < j && !solution.solved; ++i) {
+                usize const corners[] = { i, j, k };
+                f64 sides[3];
+                for (usize c = 0; c < 3; ++c) {
+                    PlateStar const *const a = stars + corners[(c + 1) % 3];
+                    PlateStar const *const b = stars + corners[(c + 2) % 3];
+                    sides[c] = math_sqrt((a->x - b->x) * (a->x - b->x) + (a->y - b->y) * (a->y - b->y));
+                }
+                usize order[3];
+                f64 ratios[2];
+                if (!plate_triangle_order(sides, order, ratios) || sides[order[0]] < 4.0 * tolerance) {
+                    continue;
+                }
+
+                f64 x[3];
+                f64 y[3];
+                for (usize c = 0; c < 3; ++c) {
+                    x[c] = stars[corners[order[c]]].x;
+                    y[c] = stars[corners[order[c]]].y;
+                }
+
+                // Ratios close to the border of a bin are also found in the neighbouring bins
+                usize const first = (usize) (ratios[0] * PLATE_BINS);
+                usize const second = (usize) (ratios[1] * PLATE_BINS);
+                for (usize u = first > 0 ? first - 1 : 0; u <= first + 1 && u < PLATE_BINS; ++u) {
+                    for (usize v = second > 0 ? second - 1 : 0; v <= second + 1 && v < PLATE_BINS; ++v) {
+                        usize const bin = u * PLATE_BINS + v;
+                        for (u32 slot = index->offsets[bin]; slot < index->offsets[bin + 1] && !solution.solved;
+                             ++slot) {
+                            if (math_abs(index->ratios[2 * slot] - ratios[0]) <= PLATE_RATIO_TOLERANCE &&
+                                math_abs(index->ratios[2 * slot + 1] - ratios[1]) <= PLATE_RATIO_TOLERANCE) {
+                                plate_candidate(arena, index, slot, x, y, stars, star_count, spec, tolerance,
+                                                matches, &solution);
+                                memory_arena_rewind(arena, candidate_mark);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    memory_arena_rewind(arena, mark);
+    return solution;
+}
+
+/// Retrieves the equatorial position of the pixel
+Equatorial plate_solution_position(PlateSolution const *const solution, f64 const x, f64 const y) {
+    Vector3 const center = vector3_from_equatorial(&solution->center);
+    PlatePlane const plane = plate_plane_make(&center);
+    f64 const scale = solution->scale / PLATE_ARCSECONDS_PER_RADIAN;
+
+    PlateTransform transform;
+    transform.a_re = scale * math_cosine(solution->rotation);
+    transform.a_im = scale * math_sine(solution->rotation);
+    transform.b_re = 0.0;
+    transform.b_im = 0.0;
+    transform.flipped = solution->flipped;
+
+    f64 xi;
+    f64 eta;
+    plate_transform_apply(&transform, x - solution->center_x, y - solution->center_y, &xi, &eta);
+    Vector3 const point = plate_plane_deproject(&plane, xi, eta);
+    Equatorial result = equatorial_from_vector3(&point);
+    result.right_ascension = math_modulo(result.right_ascension + 360.0, 360.0);
+    return result;
+}
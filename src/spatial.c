@@ -0,0 +1,510 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Elias Engelbert Plank
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <stdlib.h>
+
+#include <solaris/math.h>
+#include <solaris/spatial.h>
+
+enum {
+    SPATIAL_FACES = 6,
+    SPATIAL_MAX_DEPTH = 8,
+    SPATIAL_OBJECTS_PER_LEAF = 4,
+};
+
+/// Normal and the two axes of each cube face
+static f64 const spatial_face_basis[SPATIAL_FACES][3][3] = {
+    { { 1.0, 0.0, 0.0 }, { 0.0, 1.0, 0.0 }, { 0.0, 0.0, 1.0 } },
+    { { -1.0, 0.0, 0.0 }, { 0.0, -1.0, 0.0 }, { 0.0, 0.0, 1.0 } },
+    { { 0.0, 1.0, 0.0 }, { -1.0, 0.0, 0.0 }, { 0.0, 0.0, 1.0 } },
+    { { 0.0, -1.0, 0.0 }, { 1.0, 0.0, 0.0 }, { 0.0, 0.0, 1.0 } },
+    { { 0.0, 0.0, 1.0 }, { 0.0, 1.0, 0.0 }, { -1.0, 0.0, 0.0 } },
+    { { 0.0, 0.0, -1.0 }, { 0.0, 1.0, 0.0 }, { 1.0, 0.0, 0.0 } },
+};
+
+typedef enum SpatialShapeKind { SPATIAL_SHAPE_CONE, SPATIAL_SHAPE_POLYGON } SpatialShapeKind;
+
+typedef enum SpatialOverlap { SPATIAL_OVERLAP_OUTSIDE, SPATIAL_OVERLAP_PARTIAL, SPATIAL_OVERLAP_INSIDE } SpatialOverlap;
+
+/// Query shape, either a cone or a convex polygon given by its inward edge normals
+typedef struct SpatialShape {
+    SpatialShapeKind kind;
+    Vector3 center;
+    f64 radius;
+    f64 cos_radius;
+    Vector3 const *normals;
+    usize normal_count;
+} SpatialShape;
+
+/// Traversal state, collects the slots of the index whose objects are within the shape
+typedef struct SpatialVisitor {
+    SpatialIndex const *index;
+    SpatialShape const *shape;
+    usize *slots;
+    usize count;
+} SpatialVisitor;
+
+/// Dot product of the two vectors
+static f64 spatial_dot(Vector3 const *const a, Vector3 const *const b) {
+    return a->x * b->x + a->y * b->y + a->z * b->z;
+}
+
+/// Normalizes the vector
+static Vector3 spatial_normalize(Vector3 const *const vector) {
+    f64 const length = vector3_length(vector);
+    return (Vector3) { .x = vector->x / length, .y = vector->y / length, .z = vector->z / length };
+}
+
+/// Angle between the two unit vectors in degrees
+static f64 spatial_angle(Vector3 const *const a, Vector3 const *const b) {
+    f64 const dot = spatial_dot(a, b);
+    return math_arc_cosine(dot > 1.0 ? 1.0 : dot < -1.0 ? -1.0 : dot);
+}
+
+/// Unit vector of the equatorial position
+static Vector3 spatial_unit_vector(Equatorial const *const position) {
+    Equatorial unit = *position;
+    unit.distance = 1.0;
+    return vector3_from_equatorial(&unit);
+}
+
+/// Spreads the lower 16 bits of the value to the even bits
+static u32 spatial_spread(u32 value) {
+    value &= 0x0000FFFF;
+    value = (value | (value << 8)) & 0x00FF00FF;
+    value = (value | (value << 4)) & 0x0F0F0F0F;
+    value = (value | (value << 2)) & 0x33333333;
+    value = (value | (value << 1)) & 0x55555555;
+    return value;
+}
+
+/// Interleaves the cell coordinates to the morton code
+static u32 spatial_morton(u32 const i, u32 const j) {
+    return spatial_spread(i) | (spatial_spread(j) << 1);
+}
+
+/// Maps the face coordinate [-1, 1] to the gnomonic coordinate, which evens out the cell sizes
+static f64 spatial_unwarp(f64 const s) {
+    return math_tangent(45.0 * s);
+}
+
+/// Maps the gnomonic coordinate to the face coordinate [-1, 1]
+static f64 spatial_warp(f64 const u) {
+    return math_arc_tangent(u) / 45.0;
+}
+
+/// Retrieves the point on the sphere for the face coordinates
+static Vector3 spatial_face_point(usize const face, f64 const s, f64 const t) {
+    f64 const (*const basis)[3] = spatial_face_basis[face];
+    f64 const u = spatial_unwarp(s);
+    f64 const v = spatial_unwarp(t);
+    Vector3 const point = { .x = basis[0][0] + u * basis[1][0] + v * basis[2][0],
+                            .y = basis[0][1] + u * basis[1][1] + v * basis[2][1],
+                            .z = basis[0][2] + u * basis[1][2] + v * basis[2][2] };
+    return spatial_normalize(&point);
+}
+
+/// Retrieves the leaf cell of the unit vector
+static u32 spatial_leaf(Vector3 const *const point, usize const depth) {
+    f64 const ax = math_abs(point->x);
+    f64 const ay = math_abs(point->y);
+    f64 const az = math_abs(point->z);
+
+    usize face;
+    if (ax >= ay && ax >= az) {
+        face = point->x >= 0.0 ? 0 : 1;
+    } else if (ay >= az) {
+        face = point->y >= 0.0 ? 2 : 3;
+    } else {
+        face = point->z >= 0.0 ? 4 : 5;
+    }
+
+    f64 const (*const basis)[3] = spatial_face_basis[face];
+    f64 const n = point->x * basis[0][0] + point->y * basis[0][1] + point->z * basis[0][2];
+    f64 const u = (point->x * basis[1][0] + point->y * basis[1][1] + point->z * basis[1][2]) / n;
+    f64 const v = (point->x * basis[2][0] + point->y * basis[2][1] + point->z * basis[2][2]) / n;
+
+    u32 const cells = 1u << depth;
+    u32 i = (u32) ((spatial_warp(u) + 1.0) * 0.5 * (f64) cells);
+    u32 j = (u32) ((spatial_warp(v) + 1.0) * 0.5 * (f64) cells);
+    i = i < cells ? i : cells - 1;
+    j = j < cells ? j : cells - 1;
+    return (u32) face * cells * cells + spatial_morton(i, j);
+}
+
+/// Checks whether the point is within the shape
+static b8 spatial_shape_contains(SpatialShape const *const shape, Vector3 const *const point) {
+    switch (shape->kind) {
+        case SPATIAL_SHAPE_CONE:
+            return spatial_dot(&shape->center, point) >= shape->cos_radius;
+        case SPATIAL_SHAPE_POLYGON:
+            for (usize i = 0; i < shape->normal_count; ++i) {
+                if (spatial_dot(shape->normals + i, point) < 0.0) {
+                    return false;
+                }
+            }
+            return true;
+    }
+    return false;
+}
+
+/// Classifies the bounding cap of a quadtree node against the shape
+static SpatialOverlap spatial_shape_overlap(SpatialShape const *const shape,
+                                            Vector3 const *const center,
+                                            f64 const radius) {
+    switch (shape->kind) {
+        case SPATIAL_SHAPE_CONE: {
+            f64 const angle = spatial_angle(&shape->center, center);
+            if (angle > shape->radius + radius) {
+                return SPATIAL_OVERLAP_OUTSIDE;
+            }
+            return angle + radius <= shape->radius ? SPATIAL_OVERLAP_INSIDE : SPATIAL_OVERLAP_PARTIAL;
+        }
+        case SPATIAL_SHAPE_POLYGON: {
+            // Compare the elevation of the cap center above each edge plane with the cap radius
+            f64 const sin_radius = math_sine(radius);
+            SpatialOverlap result = SPATIAL_OVERLAP_INSIDE;
+            for (usize i = 0; i < shape->normal_count; ++i) {
+                f64 const elevation = spatial_dot(shape->normals + i, center);
+                if (elevation < -sin_radius) {
+                    return SPATIAL_OVERLAP_OUTSIDE;
+                }
+                if (elevation < sin_radius) {
+                    result = SPATIAL_OVERLAP_PARTIAL;
+                }
+            }
+            return result;
+        }
+    }
+    return SPATIAL_OVERLAP_PARTIAL;
+}
+
+/// Visits the slots of the leaf range [begin, end)
+static void spatial_visit_range(SpatialVisitor *const visitor, u32 const begin, u32 const end, b8 const test) {
+    SpatialIndex const *const index = visitor->index;
+    for (u32 slot = index->offsets[begin]; slot < index->offsets[end]; ++slot) {
+        if (test) {
+            Vector3 const point = { .x = index->x[slot], .y = index->y[slot], .z = index->z[slot] };
+            if (!spatial_shape_contains(visitor->shape, &point)) {
+                continue;
+            }
+        }
+        if (visitor->slots != nil) {
+            visitor->slots[visitor->count] = slot;
+        }
+        ++visitor->count;
+    }
+}
+
+/// Visits the quadtree node and its children
+static void spatial_visit_node(SpatialVisitor *const visitor,
+                               usize const face,
+                               usize const level,
+                               u32 const i,
+                               u32 const j) {
+    SpatialIndex const *const index = visitor->index;
+    usize const shift = 2 * (index->depth - level);
+    u32 const cells = 1u << index->depth;
+    u32 const begin = (u32) face * cells * cells + (spatial_morton(i, j) << shift);
+    u32 const end = begin + (1u << shift);
+    if (index->offsets[begin] == index->offsets[end]) {
+        return;
+    }
+
+    // Cell edges are great circles, so the cap around the corners bounds the cell
+    f64 const size = 2.0 / (f64) (1u << level);
+    f64 const s0 = -1.0 + size * (f64) i;
+    f64 const t0 = -1.0 + size * (f64) j;
+    Vector3 const corners[] = { spatial_face_point(face, s0, t0),
+                                spatial_face_point(face, s0 + size, t0),
+                                spatial_face_point(face, s0, t0 + size),
+                                spatial_face_point(face, s0 + size, t0 + size) };
+    Vector3 const center = spatial_face_point(face, s0 + 0.5 * size, t0 + 0.5 * size);
+    f64 radius = 0.0;
+    for (usize corner = 0; corner < ARRAY_SIZE(corners); ++corner) {
+        f64 const angle = spatial_angle(&center, corners + corner);
+        radius = angle > radius ? angle : radius;
+    }
+    radius += 1.0e-9;
+
+    switch (spatial_shape_overlap(visitor->shape, &center, radius)) {
+        case SPATIAL_OVERLAP_OUTSIDE:
+            return;
+        case SPATIAL_OVERLAP_INSIDE:
+            spatial_visit_range(visitor, begin, end, false);
+            return;
+        case SPATIAL_OVERLAP_PARTIAL:
+            break;
+    }
+
+    if (level == index->depth) {
+        spatial_visit_range(visitor, begin, end, true);
+        return;
+    }
+    for (u32 child = 0; child < 4; ++child) {
+        spatial_visit_node(visitor, face, level + 1, 2 * i + (child & 1), 2 * j + (child >> 1));
+    }
+}
+
+/// Collects the slots of all objects within the shape, in index order
+static void spatial_collect(MemoryArena *arena,
+                            SpatialVisitor *const visitor,
+                            SpatialIndex const *const index,
+                            SpatialShape const *const shape) {
+    visitor->index = index;
+    visitor->shape = shape;
+    visitor->slots = nil;
+    visitor->count = 0;
+    for (usize face = 0; face < SPATIAL_FACES; ++face) {
+        spatial_visit_node(visitor, face, 0, 0, 0);
+    }
+
+    // Second pass with the exact amount of memory
+    visitor->slots = (usize *) memory_arena_alloc(arena, visitor->count * sizeof(usize));
+    visitor->count = 0;
+    for (usize face = 0; face < SPATIAL_FACES; ++face) {
+        spatial_visit_node(visitor, face, 0, 0, 0);
+    }
+}
+
+/// Executes the query and maps the slots to catalog indices
+static void spatial_query(MemoryArena *arena,
+                          SpatialResult *const result,
+                          SpatialIndex const *const index,
+                          SpatialShape const *const shape) {
+    SpatialVisitor visitor;
+    spatial_collect(arena, &visitor, index, shape);
+    for (usize i = 0; i < visitor.count; ++i) {
+        visitor.slots[i] = index->indices[visitor.slots[i]];
+    }
+    result->indices = visitor.slots;
+    result->count = visitor.count;
+}
+
+/// Creates a cone shape
+static SpatialShape spatial_shape_cone(Equatorial const *const center, f64 const radius) {
+    SpatialShape shape;
+    shape.kind = SPATIAL_SHAPE_CONE;
+    shape.center = spatial_unit_vector(center);
+    shape.radius = radius;
+    shape.cos_radius = math_cosine(radius);
+    shape.normals = nil;
+    shape.normal_count = 0;
+    return shape;
+}
+
+/// Creates the spatial index of the catalog objects
+void spatial_index_make(MemoryArena *arena, SpatialIndex *const index, Catalog const *const catalog, usize depth) {
+    usize const count = catalog->object_count;
+    if (depth == 0) {
+        depth = 1;
+        while (depth < SPATIAL_MAX_DEPTH && ((usize) SPATIAL_FACES << (2 * depth)) * SPATIAL_OBJECTS_PER_LEAF < count) {
+            ++depth;
+        }
+    }
+    depth = depth < SPATIAL_MAX_DEPTH ? depth : SPATIAL_MAX_DEPTH;
+
+    usize const leaves = (usize) SPATIAL_FACES << (2 * depth);
+    index->depth = depth;
+    index->count = count;
+    index->offsets = (u32 *) memory_arena_alloc(arena, (leaves + 1) * sizeof(u32));
+    index->indices = (u32 *) memory_arena_alloc(arena, count * sizeof(u32));
+    index->x = (f64 *) memory_arena_alloc(arena, count * sizeof(f64));
+    index->y = (f64 *) memory_arena_alloc(arena, count * sizeof(f64));
+    index->z = (f64 *) memory_arena_alloc(arena, count * sizeof(f64));
+
+    // Unsorted unit vectors and leaf cells of the objects, released once the index is sorted
+    MemoryArenaMark const mark = memory_arena_mark(arena);
+    f64 *const x = (f64 *) memory_arena_alloc(arena, count * sizeof(f64));
+    f64 *const y = (f64 *) memory_arena_alloc(arena, count * sizeof(f64));
+    f64 *const z = (f64 *) memory_arena_alloc(arena, count * sizeof(f64));
+    u32 *const leaf = (u32 *) memory_arena_alloc(arena, count * sizeof(u32));
+    ObjectColumns const *const columns = &catalog->columns;
+    if (columns->count == count) {
+        vector3_from_equatorial_batch(columns->right_ascensions, columns->declinations, nil, x, y, z, count);
+    } else {
+        for (usize i = 0; i < count; ++i) {
+            Vector3 const point = spatial_unit_vector(&catalog->objects[i].position);
+            x[i] = point.x;
+            y[i] = point.y;
+            z[i] = point.z;
+        }
+    }
+
+    // Counting sort by leaf cell, offsets are shifted by one while placing the objects
+    for (usize i = 0; i <= leaves; ++i) {
+        index->offsets[i] = 0;
+    }
+    for (usize i = 0; i < count; ++i) {
+        Vector3 const point = { .x = x[i], .y = y[i], .z = z[i] };
+        leaf[i] = spatial_leaf(&point, depth);
+        ++index->offsets[leaf[i] + 1];
+    }
+    for (usize i = 1; i <= leaves; ++i) {
+        index->offsets[i] += index->offsets[i - 1];
+    }
+    for (usize i = 0; i < count; ++i) {
+        u32 const slot = index->offsets[leaf[i]]++;
+        index->indices[slot] = (u32) i;
+        index->x[slot] = x[i];
+        index->y[slot] = y[i];
+        index->z[slot] = z[i];
+    }
+    for (usize i = leaves; i > 0; --i) {
+        index->offsets[i] = index->offsets[i - 1];
+    }
+    index->offsets[0] = 0;
+    memory_arena_rewind(arena, mark);
+}
+
+/// Retrieves all objects within the cone
+void spatial_index_cone(MemoryArena *arena,
+                        SpatialResult *const result,
+                        SpatialIndex const *const index,
+                        Equatorial const *const center,
+                        f64 const radius) {
+    SpatialShape const shape = spatial_shape_cone(center, radius);
+    spatial_query(arena, result, index, &shape);
+}
+
+/// Retrieves all objects within the convex spherical polygon
+void spatial_index_polygon(MemoryArena *arena,
+                           SpatialResult *const result,
+                           SpatialIndex const *const index,
+                           Equatorial const *const vertices,
+                           usize const vertex_count) {
+    result->indices = nil;
+    result->count = 0;
+    if (vertex_count < 3) {
+        return;
+    }
+
+    // The normals are scratch below the result, which is moved down once they are released
+    MemoryArenaMark const mark = memory_arena_mark(arena);
+    Vector3 *const normals = (Vector3 *) memory_arena_alloc(arena, vertex_count * sizeof(Vector3));
+    Vector3 centroid = { 0.0, 0.0, 0.0 };
+    for (usize i = 0; i < vertex_count; ++i) {
+        Vector3 const vertex = spatial_unit_vector(vertices + i);
+        centroid = vector3_add(&centroid, &vertex);
+    }
+
+    // Edge planes through the origin, oriented such that the polygon is on the positive side
+    f64 orientation = 1.0;
+    for (usize i = 0; i < vertex_count; ++i) {
+        Vector3 const a = spatial_unit_vector(vertices + i);
+        Vector3 const b = spatial_unit_vector(vertices + (i + 1) % vertex_count);
+        Vector3 const normal = { .x = a.y * b.z - a.z * b.y, .y = a.z * b.x - a.x * b.z, .z = a.x * b.y - a.y * b.x };
+
+        // Repeated or antipodal vertices do not span an edge plane
+        if (!(vector3_length(&normal) > 0.0)) {
+            memory_arena_rewind(arena, mark);
+            return;
+        }
+        normals[i] = spatial_normalize(&normal);
+        if (i == 0 && spatial_dot(normals, &centroid) < 0.0) {
+            orientation = -1.0;
+        }
+        normals[i].x *= orientation;
+        normals[i].y *= orientation;
+        normals[i].z *= orientation;
+    }
+
+    SpatialShape shape;
+    shape.kind = SPATIAL_SHAPE_POLYGON;
+    shape.center = spatial_normalize(&centroid);
+    shape.radius = 0.0;
+    shape.cos_radius = 1.0;
+    shape.normals = normals;
+    shape.normal_count = vertex_count;
+    SpatialResult query;
+    spatial_query(arena, &query, index, &shape);
+
+    // Rewound blocks stay allocated, and the result never starts above the query, so copying forward is safe
+    memory_arena_rewind(arena, mark);
+    result->indices = (usize *) memory_arena_alloc(arena, query.count * sizeof(usize));
+    result->count = query.count;
+    for (usize i = 0; i < query.count; ++i) {
+        result->indices[i] = query.indices[i];
+    }
+}
+
+/// Candidate of a nearest neighbour query
+typedef struct SpatialCandidate {
+    f64 dot;
+    usize slot;
+} SpatialCandidate;
+
+/// Orders candidates by descending dot product, that is by ascending distance
+static int spatial_candidate_compare(void const *const left, void const *const right) {
+    f64 const a = ((SpatialCandidate const *) left)->dot;
+    f64 const b = ((SpatialCandidate const *) right)->dot;
+    return (a < b) - (a > b);
+}
+
+/// Retrieves the nearest objects to the specified position
+void spatial_index_nearest(MemoryArena *arena,
+                           SpatialResult *const result,
+                           SpatialIndex const *const index,
+                           Equatorial const *const center,
+                           usize count) {
+    count = count < index->count ? count : index->count;
+
+    // Start with a cone that contains about twice the requested objects on average
+    f64 const fraction = 4.0 * (f64) count / (f64) (index->count > 0 ? index->count : 1);
+    f64 radius = math_arc_cosine(fraction < 2.0 ? 1.0 - fraction : -1.0);
+    radius = radius > 1.0e-3 ? radius : 1.0e-3;
+
+    // If a cone contains enough objects, the nearest objects are all within the cone
+    SpatialShape shape = spatial_shape_cone(center, radius);
+    SpatialVisitor visitor = { .index = index, .shape = &shape, .slots = nil, .count = 0 };
+    for (;;) {
+        visitor.count = 0;
+        for (usize face = 0; face < SPATIAL_FACES; ++face) {
+            spatial_visit_node(&visitor, face, 0, 0, 0);
+        }
+        if (visitor.count >= count || shape.radius >= 180.0) {
+            break;
+        }
+        shape = spatial_shape_cone(center, shape.radius * 2.0 < 180.0 ? shape.radius * 2.0 : 180.0);
+    }
+    spatial_collect(arena, &visitor, index, &shape);
+
+    // The candidates are only needed for sorting, the slots become the result
+    MemoryArenaMark const mark = memory_arena_mark(arena);
+    SpatialCandidate *const candidates =
+            (SpatialCandidate *) memory_arena_alloc(arena, visitor.count * sizeof(SpatialCandidate));
+    for (usize i = 0; i < visitor.count; ++i) {
+        usize const slot = visitor.slots[i];
+        Vector3 const point = { .x = index->x[slot], .y = index->y[slot], .z = index->z[slot] };
+        candidates[i].dot = spatial_dot(&shape.center, &point);
+        candidates[i].slot = slot;
+    }
+    qsort(candidates, visitor.count, sizeof(SpatialCandidate), spatial_candidate_compare);
+
+    result->indices = visitor.slots;
+    result->count = count;
+    for (usize i = 0; i < count; ++i) {
+        result->indices[i] = index->indices[candidates[i].slot];
+    }
+    memory_arena_rewind(arena, mark);
+}
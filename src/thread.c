@@ -0,0 +1,362 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Elias Engelbert Plank
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <stdlib.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#include <solaris/thread.h>
+
+enum {
+    THREAD_POOL_MAX_WORKERS = 256,
+};
+
+#ifdef _WIN32
+typedef HANDLE ThreadHandle;
+typedef CRITICAL_SECTION ThreadMutex;
+typedef CONDITION_VARIABLE ThreadCondition;
+#else
+typedef pthread_t ThreadHandle;
+typedef pthread_mutex_t ThreadMutex;
+typedef pthread_cond_t ThreadCondition;
+#endif
+
+typedef struct ThreadPoolWorker {
+    ThreadPoolState *state;
+    usize index;
+} ThreadPoolWorker;
+
+struct ThreadPoolState {
+    ThreadMutex mutex;
+    ThreadCondition wake;
+    ThreadCondition done;
+    ThreadHandle *threads;
+    ThreadPoolWorker *workers;
+    MemoryArena *arenas;
+    usize worker_count;
+    usize thread_count;
+
+    // The current job, guarded by the mutex
+    ThreadTaskFunc task;
+    void *data;
+    usize count;
+    usize slices;
+    usize generation;
+    usize pending;
+    b8 shutdown;
+};
+
+#ifdef _WIN32
+static void thread_mutex_init(ThreadMutex *const mutex) {
+    InitializeCriticalSection(mutex);
+}
+
+static void thread_mutex_destroy(ThreadMutex *const mutex) {
+    DeleteCriticalSection(mutex);
+}
+
+static void thread_mutex_lock(ThreadMutex *const mutex) {
+    EnterCriticalSection(mutex);
+}
+
+static void thread_mutex_unlock(ThreadMutex *const mutex) {
+    LeaveCriticalSection(mutex);
+}
+
+static void thread_condition_init(ThreadCondition *const condition) {
+    InitializeConditionVariable(condition);
+}
+
+static void thread_condition_destroy(ThreadCondition *const condition) {
+    (void) condition;
+}
+
+static void thread_condition_wait(ThreadCondition *const condition, ThreadMutex *const mutex) {
+    SleepConditionVariableCS(condition, mutex, INFINITE);
+}
+
+static void thread_condition_broadcast(ThreadCondition *const condition) {
+    WakeAllConditionVariable(condition);
+}
+
+static usize thread_processor_count(void) {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (usize) info.dwNumberOfProcessors;
+}
+#else
+static void thread_mutex_init(ThreadMutex *const mutex) {
+    pthread_mutex_init(mutex, nil);
+}
+
+static void thread_mutex_destroy(ThreadMutex *const mutex) {
+    pthread_mutex_destroy(mutex);
+}
+
+static void thread_mutex_lock(ThreadMutex *const mutex) {
+    pthread_mutex_lock(mutex);
+}
+
+static void thread_mutex_unlock(ThreadMutex *const mutex) {
+    pthread_mutex_unlock(mutex);
+}
+
+static void thread_condition_init(ThreadCondition *const condition) {
+    pthread_cond_init(condition, nil);
+}
+
+static void thread_condition_destroy(ThreadCondition *const condition) {
+    pthread_cond_destroy(condition);
+}
+
+static void thread_condition_wait(ThreadCondition *const condition, ThreadMutex *const mutex) {
+    pthread_cond_wait(condition, mutex);
+}
+
+static void thread_condition_broadcast(ThreadCondition *const condition) {
+    pthread_cond_broadcast(condition);
+}
+
+static usize thread_processor_count(void) {
+    long const count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (usize) count : 1;
+}
+#endif
+
+/// Resets the arena of a worker, its largest block stays warm for the next job
+static void thread_pool_arena_reset(MemoryArena *const arena) {
+    if (arena->blocks > 1 || (arena->current != nil && arena->current->used > 0)) {
+        memory_arena_reset(arena);
+    }
+}
+
+/// Processes the slice of the worker for the current job
+static void thread_pool_run_slice(ThreadPoolState *const state,
+                                  usize const index,
+                                  ThreadTaskFunc const task,
+                                  void *const data,
+                                  usize const count,
+                                  usize const slices) {
+    if (index >= slices) {
+        return;
+    }
+
+    usize const begin = count * index / slices;
+    usize const end = count * (index + 1) / slices;
+    if (begin < end) {
+        task(data, begin, end, state->arenas + index);
+        thread_pool_arena_reset(state->arenas + index);
+    }
+}
+
+/// Main loop of a pool thread, waits for jobs until the pool shuts down
+static void thread_pool_worker_loop(ThreadPoolWorker *const worker) {
+    ThreadPoolState *const state = worker->state;
+    usize seen = 0;
+
+    thread_mutex_lock(&state->mutex);
+    for (;;) {
+        while (!state->shutdown && state->generation == seen) {
+            thread_condition_wait(&state->wake, &state->mutex);
+        }
+        if (state->shutdown) {
+            break;
+        }
+        seen = state->generation;
+        ThreadTaskFunc const task = state->task;
+        void *const data = state->data;
+        usize const count = state->count;
+        usize const slices = state->slices;
+        thread_mutex_unlock(&state->mutex);
+
+        thread_pool_run_slice(state, worker->index, task, data, count, slices);
+
+        thread_mutex_lock(&state->mutex);
+        if (--state->pending == 0) {
+            thread_condition_broadcast(&state->done);
+        }
+    }
+    thread_mutex_unlock(&state->mutex);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI thread_pool_worker_main(LPVOID argument) {
+    thread_pool_worker_loop(argument);
+    return 0;
+}
+
+static b8 thread_create(ThreadHandle *const thread, ThreadPoolWorker *const worker) {
+    *thread = CreateThread(nil, 0, thread_pool_worker_main, worker, 0, nil);
+    return *thread != nil;
+}
+
+static void thread_join(ThreadHandle const thread) {
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+#else
+static void *thread_pool_worker_main(void *argument) {
+    thread_pool_worker_loop(argument);
+    return nil;
+}
+
+static b8 thread_create(ThreadHandle *const thread, ThreadPoolWorker *const worker) {
+    return pthread_create(thread, nil, thread_pool_worker_main, worker) == 0;
+}
+
+static void thread_join(ThreadHandle const thread) {
+    pthread_join(thread, nil);
+}
+#endif
+
+/// Creates a new thread pool
+ThreadPool thread_pool_make(usize workers) {
+    if (workers == 0) {
+        workers = thread_processor_count();
+    }
+    if (workers > THREAD_POOL_MAX_WORKERS) {
+        workers = THREAD_POOL_MAX_WORKERS;
+    }
+
+    ThreadPool pool;
+    pool.workers = 0;
+    pool.state = nil;
+
+    ThreadPoolState *const state = malloc(sizeof(ThreadPoolState));
+    if (state == nil) {
+        return pool;
+    }
+    state->threads = malloc(workers * sizeof(ThreadHandle));
+    state->workers = malloc(workers * sizeof(ThreadPoolWorker));
+    state->arenas = malloc(workers * sizeof(MemoryArena));
+    if (state->threads == nil || state->workers == nil || state->arenas == nil) {
+        free(state->arenas);
+        free(state->workers);
+        free(state->threads);
+        free(state);
+        return pool;
+    }
+
+    thread_mutex_init(&state->mutex);
+    thread_condition_init(&state->wake);
+    thread_condition_init(&state->done);
+    state->task = nil;
+    state->data = nil;
+    state->count = 0;
+    state->slices = 0;
+    state->generation = 0;
+    state->pending = 0;
+    state->shutdown = false;
+
+    // The calling thread is the first worker, so one thread less is started
+    state->thread_count = 0;
+    state->worker_count = workers;
+    for (usize i = 1; i < workers; ++i) {
+        state->workers[i].state = state;
+        state->workers[i].index = i;
+        if (!thread_create(state->threads + state->thread_count, state->workers + i)) {
+            break;
+        }
+        state->thread_count++;
+    }
+    state->worker_count = state->thread_count + 1;
+    for (usize i = 0; i < state->worker_count; ++i) {
+        state->arenas[i] = memory_arena_identity(ALIGNMENT8);
+    }
+
+    pool.workers = state->worker_count;
+    pool.state = state;
+    return pool;
+}
+
+/// Destroys the thread pool and joins its threads
+void thread_pool_destroy(ThreadPool *const pool) {
+    ThreadPoolState *const state = pool->state;
+    if (state == nil) {
+        return;
+    }
+
+    thread_mutex_lock(&state->mutex);
+    state->shutdown = true;
+    thread_condition_broadcast(&state->wake);
+    thread_mutex_unlock(&state->mutex);
+
+    for (usize i = 0; i < state->thread_count; ++i) {
+        thread_join(state->threads[i]);
+    }
+    for (usize i = 0; i < state->worker_count; ++i) {
+        memory_arena_destroy(state->arenas + i);
+    }
+    thread_condition_destroy(&state->done);
+    thread_condition_destroy(&state->wake);
+    thread_mutex_destroy(&state->mutex);
+    free(state->arenas);
+    free(state->workers);
+    free(state->threads);
+    free(state);
+
+    pool->workers = 0;
+    pool->state = nil;
+}
+
+/// Splits the range into one contiguous slice per worker and waits until every slice is processed
+void thread_pool_for(ThreadPool *const pool, usize const count, ThreadTaskFunc const task, void *const data) {
+    ThreadPoolState *const state = pool->state;
+    if (state == nil) {
+        MemoryArena arena = memory_arena_identity(ALIGNMENT8);
+        task(data, 0, count, &arena);
+        memory_arena_destroy(&arena);
+        return;
+    }
+    if (state->thread_count == 0 || count < 2) {
+        task(data, 0, count, state->arenas);
+        thread_pool_arena_reset(state->arenas);
+        return;
+    }
+
+    // Small jobs use fewer slices than workers, the remaining workers skip the job
+    usize const slices = count < state->worker_count ? count : state->worker_count;
+    thread_mutex_lock(&state->mutex);
+    state->task = task;
+    state->data = data;
+    state->count = count;
+    state->slices = slices;
+    state->pending = state->thread_count;
+    state->generation++;
+    thread_condition_broadcast(&state->wake);
+    thread_mutex_unlock(&state->mutex);
+
+    thread_pool_run_slice(state, 0, task, data, count, slices);
+
+    thread_mutex_lock(&state->mutex);
+    while (state->pending > 0) {
+        thread_condition_wait(&state->done, &state->mutex);
+    }
+    thread_mutex_unlock(&state->mutex);
+}
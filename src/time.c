@@ -21,11 +21,22 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <stdio.h>
 #include <time.h>
 
+#if defined(_MSC_VER) && !defined(__clang__)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <stdatomic.h>
+#endif
+
 #include <solaris/math.h>
 #include <solaris/time.h>
 
+#include "dispatch.h"
+#include "kernel.h"
+
 /// Checks if the specified integer set contains the candidate
 static b8 integer_set_contains(u64 const *const numbers, usize const count, u64 const candidate) {
     for (usize i = 0; i < count; ++i) {
@@ -64,135 +75,120 @@ s64 time_days_in_month(Time const *const date) {
     return 0;
 }
 
-/// Adds the number of years to the specified DateTime
-void time_add_years(Time *date, s64 const years) {
-    date->year += years;
+/// Divides the integers and rounds towards negative infinity
+static s64 time_floor_div(s64 const a, s64 const b) {
+    s64 const quotient = a / b;
+    return (a % b != 0 && (a < 0) != (b < 0)) ? quotient - 1 : quotient;
 }
 
-/// Adds the number of months to the specified DateTime
-void time_add_months(Time *date, s64 const months) {
-    s64 const potentialYears = months / 12;
-    if (math_abs((f64) (potentialYears)) > 0) {
-        time_add_years(date, potentialYears);
-        time_add_months(date, months % 12);
-        return;
-    }
-    if (months > 0) {
-        if (date->month + months > 12) {
-            time_add_years(date, 1);
-            time_add_months(date, months - 12);
-        } else {
-            date->month += months;
-        }
-    } else if (months < 0) {
-        if (date->month + months < 1) {
-            time_add_years(date, -1);
-            time_add_months(date, months + 12);
-        } else {
-            date->month += months;
-        }
-    }
+/// Retrieves the non-negative remainder of the floored division
+static s64 time_floor_mod(s64 const a, s64 const b) {
+    return a - time_floor_div(a, b) * b;
 }
 
-/// Adds the number of days to the specified DateTime
-void time_add_days(Time *date, s64 days);
-
-/// Adds the number of days to the specified DateTime with respect to the days in month
-void time_add_days_with_month_days(Time *date, s64 const days, s64 const monthDays) {
-    if (days > 0) {
-        if (date->day + days > monthDays) {
-            time_add_months(date, 1);
-            time_add_days(date, days - monthDays);
-        } else {
-            date->day += days;
-        }
-    } else if (days < 0) {
-        if (date->day + days < 1) {
-            time_add_months(date, -1);
-            time_add_days(date, days + time_days_in_month(date));
-        } else {
-            date->day += days;
-        }
-    }
+/// Retrieves the day of the year that starts in march, so that the leap day is the last day
+static s64 time_day_of_march_year(s64 const month, s64 const day) {
+    s64 const march_month = month > 2 ? month - 3 : month + 9;
+    return (153 * march_month + 2) / 5 + day - 1;
 }
 
-/// Adds the number of days to the specified DateTime
-void time_add_days(Time *date, s64 const days) {
-    time_add_days_with_month_days(date, days, time_days_in_month(date));
+/// Computes the modified julian day of the date in the proleptic gregorian calendar
+static s64 time_days_from_gregorian(s64 const year, s64 const month, s64 const day) {
+    s64 const march_year = month <= 2 ? year - 1 : year;
+    s64 const era = time_floor_div(march_year, 400);
+    s64 const year_of_era = march_year - era * 400;
+    s64 const day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + time_day_of_march_year(month, day);
+    return era * 146097 + day_of_era - 678881;
 }
 
-/// Adds the number of hours to the specified DateTime
-void time_add_hours(Time *date, s64 const hours) {
-    s64 const potential_days = hours / 24;
-    if (math_abs((f64) (potential_days)) > 0) {
-        time_add_days(date, potential_days);
-        time_add_hours(date, hours % 24);
-        return;
-    }
-    if (hours > 0) {
-        if (date->hour + hours > 23) {
-            time_add_days(date, 1);
-            time_add_hours(date, hours - 24);
-        } else {
-            date->hour += hours;
-        }
-    } else if (hours < 0) {
-        if (date->hour + hours < 0) {
-            time_add_days(date, -1);
-            time_add_hours(date, hours + 24);
-        } else {
-            date->hour += hours;
-        }
-    }
+/// Computes the modified julian day of the date in the julian calendar
+static s64 time_days_from_julian(s64 const year, s64 const month, s64 const day) {
+    s64 const march_year = month <= 2 ? year - 1 : year;
+    s64 const cycle = time_floor_div(march_year, 4);
+    s64 const year_of_cycle = march_year - cycle * 4;
+    return cycle * 1461 + year_of_cycle * 365 + time_day_of_march_year(month, day) - 678883;
+}
+
+/// Sets the date of the march year and its day
+static void time_date_from_march_year(Time *const date, s64 const march_year, s64 const day_of_year) {
+    s64 const march_month = (5 * day_of_year + 2) / 153;
+    date->day = day_of_year - (153 * march_month + 2) / 5 + 1;
+    date->month = march_month < 10 ? march_month + 3 : march_month - 9;
+    date->year = date->month <= 2 ? march_year + 1 : march_year;
+}
+
+/// Sets the date of the modified julian day in the proleptic gregorian calendar
+static void time_gregorian_from_days(Time *const date, s64 const days) {
+    s64 const shifted = days + 678881;
+    s64 const era = time_floor_div(shifted, 146097);
+    s64 const day_of_era = shifted - era * 146097;
+    s64 const year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    s64 const day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    time_date_from_march_year(date, year_of_era + era * 400, day_of_year);
+}
+
+/// Sets the date of the modified julian day in the julian calendar
+static void time_julian_from_days(Time *const date, s64 const days) {
+    s64 const shifted = days + 678883;
+    s64 const cycle = time_floor_div(shifted, 1461);
+    s64 const day_of_cycle = shifted - cycle * 1461;
+    s64 const year_of_cycle = day_of_cycle / 365 < 3 ? day_of_cycle / 365 : 3;
+    time_date_from_march_year(date, year_of_cycle + cycle * 4, day_of_cycle - 365 * year_of_cycle);
+}
+
+/// Adds the number of years to the specified DateTime
+static void time_add_years(Time *const date, s64 const years) {
+    date->year += years;
+}
+
+/// Adds the number of months to the specified DateTime
+static void time_add_months(Time *const date, s64 const months) {
+    s64 const total = date->year * 12 + date->month - 1 + months;
+    date->year = time_floor_div(total, 12);
+    date->month = time_floor_mod(total, 12) + 1;
 }
 
-/// Adds the number of minutes to the specified DateTime
-void time_add_minutes(Time *date, s64 const minutes) {
-    s64 const potential_hours = minutes / 60;
-    if (math_abs((f64) (potential_hours)) > 0) {
-        time_add_hours(date, potential_hours);
-        time_add_minutes(date, potential_hours % 60);
+/// Adds the number of days to the specified DateTime
+static void time_add_days(Time *const date, s64 const days) {
+    // Steps within the month need no calendar, except for the month of the calendar switch
+    s64 const day = date->day + days;
+    b8 const calendar_switch = date->year == 1582 && date->month == 10;
+    if (day >= 1 && day <= 28 && date->month >= 1 && date->month <= 12 && !calendar_switch) {
+        date->day = day;
         return;
     }
-    if (minutes > 0) {
-        if (date->minute + minutes > 59) {
-            time_add_hours(date, 1);
-            time_add_minutes(date, minutes - 60);
-        } else {
-            date->minute += minutes;
-        }
-    } else if (minutes < 0) {
-        if (date->minute + minutes < 0) {
-            time_add_hours(date, -1);
-            time_add_minutes(date, minutes + 60);
-        } else {
-            date->minute += minutes;
-        }
-    }
+
+    Instant instant = instant_from_time(date);
+    instant.day += days;
+    *date = instant_to_time(&instant);
 }
 
-/// Adds the number of seconds to the specified DateTime
-void time_add_seconds(Time *date, s64 const seconds) {
-    s64 const potential_minutes = seconds / 60;
-    if (math_abs((f64) (potential_minutes)) > 0) {
-        time_add_minutes(date, potential_minutes);
-        time_add_seconds(date, seconds % 60);
-        return;
+/// Adds the amount to the field if the result stays within [0, limit)
+static b8 time_add_within(s64 *const field, s64 const amount, s64 const limit) {
+    s64 const value = *field + amount;
+    if (value < 0 || value >= limit) {
+        return false;
     }
-    if (seconds > 0) {
-        if (date->second + seconds > 59) {
-            time_add_minutes(date, 1);
-            time_add_seconds(date, seconds - 60);
-        } else {
-            date->second += seconds;
-        }
-    } else if (seconds < 0) {
-        if (date->second + seconds < 0) {
-            time_add_minutes(date, -1);
-            time_add_seconds(date, seconds + 60);
-        } else {
-            date->second += seconds;
-        }
+    *field = value;
+    return true;
+}
+
+/// Adds the amount of the unit in milliseconds to the specified DateTime
+static void time_add_scaled(Time *const date, s64 const amount, s64 const unit_milliseconds) {
+    // Whole days are split off first, so that large amounts cannot overflow
+    s64 const units_per_day = 86400000 / unit_milliseconds;
+    s64 const days = time_floor_div(amount, units_per_day);
+    s64 const of_day = ((date->hour * 60 + date->minute) * 60 + date->second) * 1000 + date->millisecond;
+    s64 const milliseconds = of_day + (amount - days * units_per_day) * unit_milliseconds;
+    s64 const carry = time_floor_div(milliseconds, 86400000);
+    s64 const remaining = milliseconds - carry * 86400000;
+
+    date->hour = remaining / 3600000;
+    date->minute = remaining / 60000 % 60;
+    date->second = remaining / 1000 % 60;
+    date->millisecond = remaining % 1000;
+    if (days + carry != 0) {
+        time_add_days(date, days + carry);
     }
 }
 
@@ -200,13 +196,19 @@ void time_add_seconds(Time *date, s64 const seconds) {
 void time_add(Time *date, s64 const amount, TimeUnit const unit) {
     switch (unit) {
         case UNIT_SECONDS:
-            time_add_seconds(date, amount);
+            if (!time_add_within(&date->second, amount, 60)) {
+                time_add_scaled(date, amount, 1000);
+            }
             break;
         case UNIT_MINUTES:
-            time_add_minutes(date, amount);
+            if (!time_add_within(&date->minute, amount, 60)) {
+                time_add_scaled(date, amount, 60000);
+            }
             break;
         case UNIT_HOURS:
-            time_add_hours(date, amount);
+            if (!time_add_within(&date->hour, amount, 24)) {
+                time_add_scaled(date, amount, 3600000);
+            }
             break;
         case UNIT_DAYS:
             time_add_days(date, amount);
@@ -220,50 +222,227 @@ void time_add(Time *date, s64 const amount, TimeUnit const unit) {
     }
 }
 
-/// Retrieves the local DateTime
-Time time_now(void) {
-    time_t const now = time(nil);
-    struct tm const *ltm = localtime(&now);
+/// Creates the instant of the date
+Instant instant_from_time(Time const *const date) {
+    // Months out of range carry into the year, all other fields carry through the day
+    s64 const total_months = date->year * 12 + date->month - 1;
+    s64 const year = time_floor_div(total_months, 12);
+    s64 const month = time_floor_mod(total_months, 12) + 1;
+
+    // Dates up to 1582-10-04 are in the julian calendar, the same switch as time_mjdn
+    s64 const day = 10000 * year + 100 * month + date->day <= 15821004
+                            ? time_days_from_julian(year, month, date->day)
+                            : time_days_from_gregorian(year, month, date->day);
+
+    s64 const seconds = (date->hour * 60 + date->minute) * 60 + date->second;
+    Instant instant = { .day = day, .nanosecond = 0 };
+    instant_add_nanoseconds(&instant, seconds * 1000000000 + date->millisecond * 1000000);
+    return instant;
+}
+
+/// Converts the instant to a date
+Time instant_to_time(Instant const *const instant) {
+    Time date;
+    // The gregorian calendar starts on 1582-10-15, which is the modified julian day -100840
+    if (instant->day < -100840) {
+        time_julian_from_days(&date, instant->day);
+    } else {
+        time_gregorian_from_days(&date, instant->day);
+    }
+
+    s64 const milliseconds = instant->nanosecond / 1000000;
+    date.hour = milliseconds / 3600000;
+    date.minute = milliseconds / 60000 % 60;
+    date.second = milliseconds / 1000 % 60;
+    date.millisecond = milliseconds % 1000;
+    return date;
+}
+
+/// Creates the instant of the julian day number
+Instant instant_from_jdn(f64 const jdn) {
+    f64 const mjdn = jdn - 2400000.5;
+    f64 const day = math_floor(mjdn);
+    Instant instant = { .day = (s64) day, .nanosecond = 0 };
+    instant_add_nanoseconds(&instant, (s64) ((mjdn - day) * INSTANT_NANOSECONDS_PER_DAY + 0.5));
+    return instant;
+}
+
+/// Calculates the julian day number of the instant
+f64 instant_jdn(Instant const *const instant) {
+    // The integral part is added last, so that the fraction keeps its precision
+    return (f64) instant->nanosecond / INSTANT_NANOSECONDS_PER_DAY + 0.5 + ((f64) instant->day + 2400000.0);
+}
+
+/// Calculates the mean julian day number of the instant
+f64 instant_mjdn(Instant const *const instant) {
+    return (f64) instant->day + (f64) instant->nanosecond / INSTANT_NANOSECONDS_PER_DAY;
+}
+
+/// Adds the number of nanoseconds to the instant
+void instant_add_nanoseconds(Instant *const instant, s64 const nanoseconds) {
+    s64 const days = time_floor_div(nanoseconds, INSTANT_NANOSECONDS_PER_DAY);
+    s64 const nanosecond = instant->nanosecond + (nanoseconds - days * INSTANT_NANOSECONDS_PER_DAY);
+    s64 const carry = nanosecond >= INSTANT_NANOSECONDS_PER_DAY ? 1 : 0;
+    instant->day += days + carry;
+    instant->nanosecond = nanosecond - carry * INSTANT_NANOSECONDS_PER_DAY;
+}
+
+/// Adds the specified amount to the instant
+void instant_add(Instant *const instant, s64 const amount, TimeUnit const unit) {
+    s64 unit_seconds;
+    switch (unit) {
+        case UNIT_SECONDS:
+            unit_seconds = 1;
+            break;
+        case UNIT_MINUTES:
+            unit_seconds = 60;
+            break;
+        case UNIT_HOURS:
+            unit_seconds = 3600;
+            break;
+        case UNIT_DAYS:
+            instant->day += amount;
+            return;
+        case UNIT_MONTHS:
+        case UNIT_YEARS:
+        default: {
+            // Calendar units go through the date, the part below milliseconds is kept
+            s64 const sub_millisecond = instant->nanosecond % 1000000;
+            Time date = instant_to_time(instant);
+            time_add(&date, amount, unit);
+            *instant = instant_from_time(&date);
+            instant->nanosecond += sub_millisecond;
+            return;
+        }
+    }
+
+    // Whole days are split off first, so that large amounts cannot overflow the nanoseconds
+    s64 const units_per_day = 86400 / unit_seconds;
+    s64 const days = time_floor_div(amount, units_per_day);
+    instant->day += days;
+    instant_add_nanoseconds(instant, (amount - days * units_per_day) * unit_seconds * 1000000000);
+}
+
+/// Calculates the difference of the two instants in seconds
+f64 instant_difference(Instant const *const a, Instant const *const b) {
+    return (f64) (b->day - a->day) * SECONDS_PER_DAY + (f64) (b->nanosecond - a->nanosecond) * 1.0e-9;
+}
+
+/// Compares the two instants
+s64 instant_compare(Instant const *const left, Instant const *const right) {
+    if (left->day != right->day) {
+        return left->day < right->day ? -1 : 1;
+    }
+    if (left->nanosecond != right->nanosecond) {
+        return left->nanosecond < right->nanosecond ? -1 : 1;
+    }
+    return 0;
+}
+
+/// Time zone transitions fall on quarter hours, so an offset stays valid within its quarter hour
+#define TIME_ZONE_PERIOD 900
+
+/// The cache packs the quarter hour of the read, counted from one, above the offset in seconds.
+/// Offset and validity are replaced at once, and the zero of the empty cache never matches.
+#if defined(_MSC_VER) && !defined(__clang__)
+static LONG64 volatile time_zone_offset_cache = 0;
+
+static u64 time_zone_cache_load(void) {
+    return (u64) InterlockedCompareExchange64(&time_zone_offset_cache, 0, 0);
+}
+
+static void time_zone_cache_store(u64 const cache) {
+    InterlockedExchange64(&time_zone_offset_cache, (LONG64) cache);
+}
+#else
+static _Atomic u64 time_zone_offset_cache = 0;
+
+static u64 time_zone_cache_load(void) {
+    return atomic_load_explicit(&time_zone_offset_cache, memory_order_relaxed);
+}
+
+static void time_zone_cache_store(u64 const cache) {
+    atomic_store_explicit(&time_zone_offset_cache, cache, memory_order_relaxed);
+}
+#endif
+
+/// Retrieves the quarter hour of the timestamp as it is stored in the cache
+static u64 time_zone_quarter(time_t const timestamp) {
+    return (u64) ((s64) timestamp / TIME_ZONE_PERIOD) + 1;
+}
 
+/// Converts the broken-down time of the C library to a DateTime
+static Time time_from_tm(struct tm const *const tm) {
     Time result;
-    result.year = (s64) (ltm->tm_year) + 1900;
-    result.month = (s64) (ltm->tm_mon) + 1;
-    result.day = (s64) (ltm->tm_mday);
-    result.hour = (s64) (ltm->tm_hour);
-    result.minute = (s64) (ltm->tm_min);
-    result.second = (s64) (ltm->tm_sec);
+    result.year = (s64) (tm->tm_year) + 1900;
+    result.month = (s64) (tm->tm_mon) + 1;
+    result.day = (s64) (tm->tm_mday);
+    result.hour = (s64) (tm->tm_hour);
+    result.minute = (s64) (tm->tm_min);
+    result.second = (s64) (tm->tm_sec);
     result.millisecond = 0;
     return result;
 }
 
+/// Retrieves the local DateTime of the timestamp with the reentrant variant of localtime
+static Time time_local_from_timestamp(time_t const timestamp) {
+    struct tm tm;
+#ifdef _WIN32
+    localtime_s(&tm, &timestamp);
+#else
+    localtime_r(&timestamp, &tm);
+#endif
+    return time_from_tm(&tm);
+}
+
+/// Retrieves the local DateTime
+Time time_now(void) {
+    return time_local_from_timestamp(time(nil));
+}
+
 /// Retrieves the corresponding UTC DateTime
 Time time_utc(void) {
-    time_t const now = time(nil);
-    struct tm const *ltm = gmtime(&now);
+    return time_from_unix((s64) time(nil), 0);
+}
 
-    Time result;
-    result.year = (s64) (ltm->tm_year) + 1900;
-    result.month = (s64) (ltm->tm_mon) + 1;
-    result.day = (s64) (ltm->tm_mday);
-    result.hour = (s64) (ltm->tm_hour);
-    result.minute = (s64) (ltm->tm_min);
-    result.second = (s64) (ltm->tm_sec);
-    result.millisecond = 0;
-    return result;
+/// Reads the offset of the local time zone to UTC at the timestamp and caches it for its quarter hour
+static s64 time_zone_read(time_t const now) {
+    Time const local = time_local_from_timestamp(now);
+    s64 const offset = time_unix_offset(&local, 0) - (s64) now;
+    time_zone_cache_store((time_zone_quarter(now) << 32) | (u32) (s32) offset);
+    return offset;
+}
+
+/// Reads the offset of the local time zone to UTC in seconds again
+s64 time_zone_refresh(void) {
+    return time_zone_read(time(nil));
+}
+
+/// Retrieves the cached offset of the local time zone to UTC in seconds
+s64 time_utc_offset(void) {
+    time_t const now = time(nil);
+    u64 const cache = time_zone_cache_load();
+    if (cache >> 32 == time_zone_quarter(now)) {
+        return (s64) (s32) (u32) cache;
+    }
+    return time_zone_read(now);
 }
 
 /// Retrieves the UTC DateTime which is relative to the specified local time
 Time time_utc_local(Time const *const local_time) {
-    Time const now = time_now();
-    Time const utc = time_utc();
+    return time_utc_local_offset(local_time, time_utc_offset());
+}
+
+/// Retrieves the UTC DateTime of the local time with the explicit offset
+Time time_utc_local_offset(Time const *const local_time, s64 const utc_offset) {
     Time result = *local_time;
-    time_add_seconds(&result, time_difference(&now, &utc));
+    time_add(&result, -utc_offset, UNIT_SECONDS);
     return result;
 }
 
 /// Calculates the difference of the two DateTimes in seconds
 s64 time_difference(Time const *const a, Time const *const b) {
-    return time_unix(b) - time_unix(a);
+    return time_unix_offset(b, 0) - time_unix_offset(a, 0);
 }
 
 /// Calculates the julian day number for the given date
@@ -299,6 +478,11 @@ f64 time_mjdn(Time const *const date) {
 /// Calculates the julian centuries since J2000 for the specified date
 f64 time_jc(Time const *const date, b8 const floor) {
     f64 const jdn = floor ? math_floor(time_jdn(date)) : time_jdn(date);
+    return time_jc_jdn(jdn);
+}
+
+/// Calculates the julian centuries since J2000 for the specified julian day number
+f64 time_jc_jdn(f64 const jdn) {
     return (jdn - 2451545.0) / 36525.0;
 }
 
@@ -309,7 +493,11 @@ f64 time_be(Time const *const date) {
 
 /// Calculates the greenwich mean sidereal time in math_degrees
 f64 time_gmst(Time const *const utc) {
-    f64 const mjdn = time_mjdn(utc);
+    return time_gmst_mjdn(time_mjdn(utc));
+}
+
+/// Calculates the greenwich mean sidereal time in math_degrees
+f64 time_gmst_mjdn(f64 const mjdn) {
     f64 const mjdn_floor = math_floor(mjdn);
     f64 const ut = SECONDS_PER_DAY * (mjdn - mjdn_floor);
     f64 const t = (mjdn - 51544.5) / 36525.0;
@@ -319,18 +507,228 @@ f64 time_gmst(Time const *const utc) {
     return math_modulo(math_degrees((PI2 / SECONDS_PER_DAY) * math_modulo(gmst, SECONDS_PER_DAY)), 360.0);
 }
 
+/// Creates the instant of the mean julian day number, rounded to milliseconds
+static Instant instant_from_mjdn_milliseconds(f64 const mjdn) {
+    f64 const day = math_floor(mjdn);
+    s64 const milliseconds = (s64) ((mjdn - day) * (SECONDS_PER_DAY * 1000.0) + 0.5);
+    Instant instant = { .day = (s64) day, .nanosecond = 0 };
+    instant_add_nanoseconds(&instant, milliseconds * 1000000);
+    return instant;
+}
+
+/// Converts the julian day number to a date
+Time time_from_jdn(f64 const jdn) {
+    return time_from_mjdn(jdn - 2400000.5);
+}
+
+/// Converts the mean julian day number to a date
+Time time_from_mjdn(f64 const mjdn) {
+    Instant const instant = instant_from_mjdn_milliseconds(mjdn);
+    return instant_to_time(&instant);
+}
+
+/// Converts arrays of julian day numbers to dates
+void time_from_jdn_batch(f64 const *const jdn, Time *const dates, usize const count) {
+    // The calendar date is only computed when the day changes
+    s64 last_day = 0;
+    Time last_date = { 0 };
+    for (usize i = 0; i < count; ++i) {
+        Instant const instant = instant_from_mjdn_milliseconds(jdn[i] - 2400000.5);
+        if (i == 0 || instant.day != last_day) {
+            last_date = instant_to_time(&instant);
+            last_day = instant.day;
+        }
+
+        s64 const milliseconds = instant.nanosecond / 1000000;
+        dates[i] = last_date;
+        dates[i].hour = milliseconds / 3600000;
+        dates[i].minute = milliseconds / 60000 % 60;
+        dates[i].second = milliseconds / 1000 % 60;
+        dates[i].millisecond = milliseconds % 1000;
+    }
+}
+
+/// Writes the value as decimal digits of fixed width
+static void time_write_digits(char *const buffer, s64 value, usize const width) {
+    for (usize i = width; i > 0; --i) {
+        buffer[i - 1] = (char) ('0' + value % 10);
+        value /= 10;
+    }
+}
+
+/// Formats the date as ISO 8601 string
+usize time_iso8601(Time const *const date, char *const buffer) {
+    if (date->year < 0 || date->year > 9999) {
+        // Expanded representation with sign, which needs more than four digits of the year
+        int const length = snprintf(buffer,
+                                    TIME_ISO8601_SIZE,
+                                    "%+07lld-%02lld-%02lldT%02lld:%02lld:%02lld.%03lld",
+                                    (long long) date->year,
+                                    (long long) date->month,
+                                    (long long) date->day,
+                                    (long long) date->hour,
+                                    (long long) date->minute,
+                                    (long long) date->second,
+                                    (long long) date->millisecond);
+        return length > 0 ? (usize) length : 0;
+    }
+
+    // YYYY-MM-DDTHH:MM:SS.sss
+    time_write_digits(buffer, date->year, 4);
+    buffer[4] = '-';
+    time_write_digits(buffer + 5, date->month, 2);
+    buffer[7] = '-';
+    time_write_digits(buffer + 8, date->day, 2);
+    buffer[10] = 'T';
+    time_write_digits(buffer + 11, date->hour, 2);
+    buffer[13] = ':';
+    time_write_digits(buffer + 14, date->minute, 2);
+    buffer[16] = ':';
+    time_write_digits(buffer + 17, date->second, 2);
+    buffer[19] = '.';
+    time_write_digits(buffer + 20, date->millisecond, 3);
+    buffer[23] = '\0';
+    return 23;
+}
+
+/// Formats arrays of julian day numbers as ISO 8601 strings
+void time_iso8601_batch(f64 const *const jdn, char *const strings, usize const count) {
+    Time dates[256];
+    for (usize first = 0; first < count; first += ARRAY_SIZE(dates)) {
+        usize const chunk = count - first < ARRAY_SIZE(dates) ? count - first : ARRAY_SIZE(dates);
+        time_from_jdn_batch(jdn + first, dates, chunk);
+        for (usize i = 0; i < chunk; ++i) {
+            time_iso8601(dates + i, strings + (first + i) * TIME_ISO8601_SIZE);
+        }
+    }
+}
+
+/// Calculates the julian day numbers and julian centuries of arrays of instants
+void instant_jdn_batch(Instant const *const instants, f64 *const jdn, f64 *const jc, usize const count) {
+    for (usize i = 0; i < count; ++i) {
+        jdn[i] = instant_jdn(instants + i);
+    }
+    if (jc != nil) {
+        for (usize i = 0; i < count; ++i) {
+            jc[i] = (jdn[i] - 2451545.0) / 36525.0;
+        }
+    }
+}
+
+/// Reduces the angle in degrees to [0, 360)
+DISPATCH_INLINE f64 time_gmst_reduce(f64 const angle) {
+    f64 const reduced = angle - 360.0 * kernel_round(angle * (1.0 / 360.0));
+    return reduced < 0.0 ? reduced + 360.0 : reduced;
+}
+
+/// Computes the greenwich mean sidereal time in degrees of the days since J2000 with the
+/// continuous form of the IAU 1982 expression, which is linear with a small secular correction
+DISPATCH_INLINE f64 time_gmst_correction(f64 const days) {
+    f64 const t = days / 36525.0;
+    return t * t * (0.000387933 - t / 38710000.0);
+}
+
+/// Batch kernel of the greenwich mean sidereal time of the mean julian day numbers
+DISPATCH_INLINE void time_gmst_mjdn_kernel(f64 const *const restrict mjdn,
+                                           f64 *const restrict gmst,
+                                           usize const count) {
+    for (usize i = 0; i < count; ++i) {
+        f64 const days = mjdn[i] - 51544.5;
+        gmst[i] = time_gmst_reduce(280.46061837 + 360.98564736629 * days + time_gmst_correction(days));
+    }
+}
+
+/// Batch kernel of the greenwich mean sidereal time along a uniform timeline, where the
+/// linear part advances by the reduced rotation of one step
+DISPATCH_INLINE void time_gmst_timeline_kernel(f64 const start_days,
+                                               f64 const step,
+                                               f64 *const restrict gmst,
+                                               usize const count) {
+    f64 const base = time_gmst_reduce(280.46061837 + 360.98564736629 * start_days);
+    f64 const increment = time_gmst_reduce(360.98564736629 * step);
+    // The index is converted from 32-bit integers in chunks, which vectorizes without 64-bit conversions
+    for (usize first = 0; first < count; first += 4096) {
+        s32 const chunk = (s32) (count - first < 4096 ? count - first : 4096);
+        f64 const offset = (f64) first;
+        f64 *const restrict chunk_gmst = gmst + first;
+        for (s32 i = 0; i < chunk; ++i) {
+            f64 const index = offset + (f64) i;
+            f64 const correction = time_gmst_correction(start_days + index * step);
+            chunk_gmst[i] = time_gmst_reduce(base + index * increment + correction);
+        }
+    }
+}
+
+#if DISPATCH_X86
+DISPATCH_TARGET_AVX2 static void time_gmst_mjdn_avx2(f64 const *mjdn, f64 *gmst, usize count) {
+    time_gmst_mjdn_kernel(mjdn, gmst, count);
+}
+
+DISPATCH_TARGET_AVX512 static void time_gmst_mjdn_avx512(f64 const *mjdn, f64 *gmst, usize count) {
+    time_gmst_mjdn_kernel(mjdn, gmst, count);
+}
+
+DISPATCH_TARGET_AVX2 static void time_gmst_timeline_avx2(f64 start_days, f64 step, f64 *gmst, usize count) {
+    time_gmst_timeline_kernel(start_days, step, gmst, count);
+}
+
+DISPATCH_TARGET_AVX512 static void time_gmst_timeline_avx512(f64 start_days, f64 step, f64 *gmst, usize count) {
+    time_gmst_timeline_kernel(start_days, step, gmst, count);
+}
+#endif
+
+/// Calculates the greenwich mean sidereal time in degrees of arrays of mean julian day numbers
+void time_gmst_mjdn_batch(f64 const *const mjdn, f64 *const gmst, usize const count) {
+#if DISPATCH_X86
+    switch (dispatch_level()) {
+        case DISPATCH_LEVEL_AVX512:
+            time_gmst_mjdn_avx512(mjdn, gmst, count);
+            return;
+        case DISPATCH_LEVEL_AVX2:
+            time_gmst_mjdn_avx2(mjdn, gmst, count);
+            return;
+        case DISPATCH_LEVEL_BASELINE:
+            break;
+    }
+#endif
+    time_gmst_mjdn_kernel(mjdn, gmst, count);
+}
+
+/// Calculates the greenwich mean sidereal time in degrees along a uniform timeline
+void time_gmst_timeline(f64 const start_mjdn, f64 const step, usize const steps, f64 *const gmst) {
+    f64 const start_days = start_mjdn - 51544.5;
+#if DISPATCH_X86
+    switch (dispatch_level()) {
+        case DISPATCH_LEVEL_AVX512:
+            time_gmst_timeline_avx512(start_days, step, gmst, steps);
+            return;
+        case DISPATCH_LEVEL_AVX2:
+            time_gmst_timeline_avx2(start_days, step, gmst, steps);
+            return;
+        case DISPATCH_LEVEL_BASELINE:
+            break;
+    }
+#endif
+    time_gmst_timeline_kernel(start_days, step, gmst, steps);
+}
+
 /// Computes the unix timestamp for the date
 time_t time_unix(Time const *const date) {
-    time_t raw_time = 0;
-    time(&raw_time);
-    struct tm *time_info = localtime(&raw_time);
-    time_info->tm_year = (int) (date->year - 1900);
-    time_info->tm_mon = (int) (date->month - 1);
-    time_info->tm_mday = (int) (date->day);
-    time_info->tm_hour = (int) (date->hour);
-    time_info->tm_min = (int) (date->minute);
-    time_info->tm_sec = (int) (date->second);
-    return mktime(time_info);
+    return (time_t) time_unix_offset(date, time_utc_offset());
+}
+
+/// Computes the unix timestamp for the date with the explicit offset
+s64 time_unix_offset(Time const *const date, s64 const utc_offset) {
+    // The unix epoch is the modified julian day 40587
+    Instant const instant = instant_from_time(date);
+    return (instant.day - 40587) * 86400 + instant.nanosecond / 1000000000 - utc_offset;
+}
+
+/// Converts the unix timestamp to a DateTime with the explicit offset
+Time time_from_unix(s64 const timestamp, s64 const utc_offset) {
+    Instant instant = { .day = 40587, .nanosecond = 0 };
+    instant_add(&instant, timestamp + utc_offset, UNIT_SECONDS);
+    return instant_to_time(&instant);
 }
 
 /// Checks if the specified date is valid
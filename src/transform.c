@@ -0,0 +1,106 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Elias Engelbert Plank
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <solaris/math.h>
+#include <solaris/object.h>
+#include <solaris/planet.h>
+#include <solaris/transform.h>
+
+/// Creates an empty transform cache
+TransformCache transform_cache_make(f64 const quantum) {
+    TransformCache cache;
+    cache.quantum = quantum > 0.0 ? quantum : 0.0;
+    for (usize slot = 0; slot < TRANSFORM_CACHE_SLOTS; ++slot) {
+        cache.objects[slot].valid = false;
+        cache.planets[slot].valid = false;
+    }
+    cache.hits = 0;
+    cache.misses = 0;
+    return cache;
+}
+
+/// Rounds the epoch to the quantum of the cache and selects its slot
+static usize transform_cache_slot(TransformCache const *const cache, f64 *const epoch) {
+    f64 const quantum = cache->quantum > 0.0 ? cache->quantum : TRANSFORM_CACHE_QUANTUM;
+    f64 const index = math_floor(*epoch / quantum + 0.5);
+    if (cache->quantum > 0.0) {
+        *epoch = index * quantum;
+    }
+    return (usize) (s64) index % TRANSFORM_CACHE_SLOTS;
+}
+
+/// Retrieves the precession from the catalog epoch of fixed objects to the equinox of date
+Matrix3x3 const *transform_cache_object(TransformCache *const cache, f64 const jdn) {
+    f64 epoch = jdn;
+    TransformCacheEntry *const entry = cache->objects + transform_cache_slot(cache, &epoch);
+    if (entry->valid && entry->epoch == epoch) {
+        cache->hits++;
+        return &entry->matrix;
+    }
+
+    cache->misses++;
+    entry->valid = true;
+    entry->epoch = epoch;
+    entry->matrix = object_precession_jdn(epoch);
+    return &entry->matrix;
+}
+
+/// Retrieves the fused transformation from the J2000 ecliptic to the equator of date
+Matrix3x3 const *transform_cache_planet(TransformCache *const cache, f64 const jdn) {
+    f64 epoch = jdn;
+    TransformCacheEntry *const entry = cache->planets + transform_cache_slot(cache, &epoch);
+    if (entry->valid && entry->epoch == epoch) {
+        cache->hits++;
+        return &entry->matrix;
+    }
+
+    cache->misses++;
+    Matrix3x3 const frame = matrix3x3_reference_plane(REFERENCE_PLANE_ECLIPTIC, REFERENCE_PLANE_EQUATORIAL, 0);
+    Matrix3x3 const precession = matrix3x3_precession(REFERENCE_PLANE_EQUATORIAL, 0, time_jc_jdn(epoch));
+    entry->valid = true;
+    entry->epoch = epoch;
+    entry->matrix = matrix3x3_mul(&precession, &frame);
+    return &entry->matrix;
+}
+
+/// Creates the time context of an instant
+TimeContext time_context_make(f64 const jdn, s64 const utc_offset) {
+    TimeContext context;
+    context.jdn = jdn;
+    context.jc = time_jc_jdn(jdn);
+    context.mjdn = jdn - 2400000.5;
+    context.gmst = time_gmst_mjdn(context.mjdn - (f64) utc_offset / SECONDS_PER_DAY);
+    context.obliquity = ecliptic_drift(context.jc);
+    context.precession = matrix3x3_precession(REFERENCE_PLANE_EQUATORIAL, 0, context.jc);
+    context.object_precession = object_precession_jdn(jdn);
+
+    Matrix3x3 const frame = matrix3x3_reference_plane(REFERENCE_PLANE_ECLIPTIC, REFERENCE_PLANE_EQUATORIAL, 0);
+    context.planet_transform = matrix3x3_mul(&context.precession, &frame);
+    context.earth = position_of_earth(context.jc);
+    return context;
+}
+
+/// Creates the time context of an instant with the UTC offset of the observer
+TimeContext time_context_observer(Time const *const date, ObserverContext const *const observer) {
+    return time_context_make(time_jdn(date), observer->utc_offset);
+}
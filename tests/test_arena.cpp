@@ -21,6 +21,11 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <cstdlib>
+#include <limits>
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 #include <solaris/arena.h>
 
@@ -87,3 +92,272 @@ TEST(MemoryArenaTest, AlignmentCorrectness) {
         memory_arena_destroy(&arena);
     }
 }
+
+TEST(MemoryArenaTest, RewindKeepsBlocks) {
+    MemoryArena arena = memory_arena_identity(ALIGNMENT8);
+    void *const persistent = memory_arena_alloc(&arena, 64);
+    EXPECT_NE(persistent, nullptr);
+
+    MemoryArenaMark const mark = memory_arena_mark(&arena);
+    void *const first = memory_arena_alloc(&arena, 128);
+    void *const large = memory_arena_alloc(&arena, 8192);
+    EXPECT_EQ(arena.blocks, 2u);
+
+    memory_arena_rewind(&arena, mark);
+    EXPECT_EQ(arena.blocks, 2u);
+    EXPECT_EQ(arena.current, mark.block);
+
+    // The same allocations land in the same memory, the large block is reused
+    EXPECT_EQ(memory_arena_alloc(&arena, 128), first);
+    EXPECT_EQ(memory_arena_alloc(&arena, 8192), large);
+    EXPECT_EQ(arena.blocks, 2u);
+
+    memory_arena_destroy(&arena);
+    EXPECT_EQ(arena.free, nullptr);
+}
+
+TEST(MemoryArenaTest, NestedRewind) {
+    MemoryArena arena = memory_arena_identity(ALIGNMENT8);
+    MemoryArenaMark const outer = memory_arena_mark(&arena);
+    memory_arena_alloc(&arena, 3000);
+
+    MemoryArenaMark const inner = memory_arena_mark(&arena);
+    memory_arena_alloc(&arena, 3000);
+    memory_arena_alloc(&arena, 3000);
+    memory_arena_rewind(&arena, inner);
+    EXPECT_EQ(arena.current->used, inner.used);
+
+    memory_arena_rewind(&arena, outer);
+    EXPECT_EQ(arena.current->used, 0u);
+    EXPECT_EQ(arena.blocks, 3u);
+
+    memory_arena_destroy(&arena);
+}
+
+TEST(MemoryArenaTest, ResetKeepsLargestBlock) {
+    MemoryArena arena = memory_arena_identity(ALIGNMENT8);
+    memory_arena_alloc(&arena, 1024);
+    void *const large = memory_arena_alloc(&arena, 65536);
+    memory_arena_alloc(&arena, 1024);
+    EXPECT_EQ(arena.blocks, 3u);
+
+    memory_arena_reset(&arena);
+    EXPECT_EQ(arena.blocks, 1u);
+    EXPECT_EQ(arena.current->used, 0u);
+    EXPECT_GE(arena.current->size, 65536u);
+    EXPECT_EQ(memory_arena_alloc(&arena, 65536), large);
+
+    memory_arena_destroy(&arena);
+}
+
+TEST(MemoryArenaTest, TotalMemoryCountsOversizedBlocks) {
+    MemoryArena arena = memory_arena_identity(ALIGNMENT8);
+    EXPECT_EQ(arena.total_memory, arena.current->size);
+
+    memory_arena_alloc(&arena, 8192);
+    EXPECT_EQ(arena.total_memory, 4096u + 8192u);
+
+    memory_arena_reset(&arena);
+    EXPECT_EQ(arena.total_memory, 8192u);
+
+    memory_arena_destroy(&arena);
+}
+
+TEST(MemoryArenaTest, GeometricGrowth) {
+    MemoryArenaSpecification spec = {};
+    spec.alignment = ALIGNMENT8;
+    spec.reserve = malloc;
+    spec.release = free;
+    spec.block_size = 1024;
+    spec.growth_factor = 2.0;
+    MemoryArena arena = memory_arena_make(&spec);
+
+    for (usize i = 0; i < 7; ++i) {
+        memory_arena_alloc(&arena, 1000);
+    }
+    EXPECT_EQ(arena.blocks, 3u);
+    EXPECT_EQ(arena.current->size, 4096u);
+    EXPECT_EQ(arena.total_memory, 1024u + 2048u + 4096u);
+
+    memory_arena_clear(&arena);
+    EXPECT_EQ(arena.current->size, 1024u);
+
+    memory_arena_destroy(&arena);
+}
+
+TEST(MemoryArenaTest, FailedReservationYieldsNil) {
+    // The address space cannot be reserved, so the arena has no block and allocations fail
+    MemoryArena arena = memory_arena_virtual(ALIGNMENT8, std::numeric_limits<usize>::max() / 2);
+    EXPECT_EQ(arena.current, nullptr);
+    EXPECT_EQ(arena.blocks, 0u);
+    EXPECT_EQ(memory_arena_alloc(&arena, 64), nullptr);
+    memory_arena_destroy(&arena);
+
+    MemoryArenaSpecification spec = {};
+    spec.alignment = ALIGNMENT8;
+    spec.reserve = [](size_t) -> void * { return nullptr; };
+    spec.release = free;
+    spec.backend = MEMORY_BACKEND_HEAP;
+    spec.block_size = 1024;
+    spec.growth_factor = 1.0;
+    MemoryArena heap = memory_arena_make(&spec);
+    EXPECT_EQ(heap.current, nullptr);
+    MemoryArenaMark const mark = memory_arena_mark(&heap);
+    EXPECT_EQ(memory_arena_alloc(&heap, 64), nullptr);
+    memory_arena_rewind(&heap, mark);
+    memory_arena_reset(&heap);
+    EXPECT_EQ(heap.total_memory, 0u);
+    memory_arena_destroy(&heap);
+}
+
+TEST(MemoryArenaTest, VirtualArenaIsContiguous) {
+    MemoryArena arena = memory_arena_virtual(ALIGNMENT8, 64u << 20);
+    ASSERT_NE(arena.current, nullptr);
+    usize const initial = arena.total_memory;
+
+    // Many allocations of different sizes stay in the reserved block
+    auto *const first = static_cast<u8 *>(memory_arena_alloc(&arena, 100));
+    u8 *last = first;
+    for (usize i = 0; i < 1000; ++i) {
+        last = static_cast<u8 *>(memory_arena_alloc(&arena, 1000 + i));
+        last[999] = 1;
+    }
+    EXPECT_EQ(arena.blocks, 1u);
+    EXPECT_GT(last, first);
+    EXPECT_GT(arena.total_memory, initial);
+    EXPECT_LT(arena.total_memory, 4u << 20);
+
+    // Rewinding keeps the committed memory
+    usize const committed = arena.total_memory;
+    memory_arena_rewind(&arena, MemoryArenaMark { arena.current, 0 });
+    EXPECT_EQ(arena.total_memory, committed);
+    EXPECT_EQ(memory_arena_alloc(&arena, 100), first);
+
+    // Allocations beyond the reservation continue in a new block
+    void *const large = memory_arena_alloc(&arena, 128u << 20);
+    EXPECT_NE(large, nullptr);
+    EXPECT_EQ(arena.blocks, 2u);
+
+    memory_arena_destroy(&arena);
+    EXPECT_EQ(arena.total_memory, 0u);
+}
+
+TEST(ConcurrentArenaTest, ThreadsAllocateDisjointMemory) {
+    ConcurrentArena arena = concurrent_arena_identity(ALIGNMENT8);
+    usize constexpr THREADS = 4;
+    usize constexpr ALLOCATIONS = 20000;
+
+    std::vector<std::vector<usize *>> pointers(THREADS);
+    std::vector<std::thread> threads;
+    for (usize t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&arena, &pointers, t] {
+            for (usize i = 0; i < ALLOCATIONS; ++i) {
+                // Sizes vary, so that regions are exhausted at different offsets
+                usize const count = 1 + (i % 7);
+                auto *const values = static_cast<usize *>(concurrent_arena_alloc(&arena, count * sizeof(usize)));
+                for (usize k = 0; k < count; ++k) {
+                    values[k] = t * ALLOCATIONS + i;
+                }
+                pointers[t].push_back(values);
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    for (usize t = 0; t < THREADS; ++t) {
+        for (usize i = 0; i < ALLOCATIONS; ++i) {
+            usize const *const values = pointers[t][i];
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(values) % ALIGNMENT8, 0u);
+            for (usize k = 0; k < 1 + (i % 7); ++k) {
+                ASSERT_EQ(values[k], t * ALLOCATIONS + i);
+            }
+        }
+    }
+    EXPECT_GE(concurrent_arena_total_memory(&arena), THREADS * ALLOCATIONS * 4 * sizeof(usize));
+
+    concurrent_arena_destroy(&arena);
+    EXPECT_EQ(arena.state, nullptr);
+}
+
+TEST(ConcurrentArenaTest, ViewAllocatesFromSharedArena) {
+    ConcurrentArena arena = concurrent_arena_identity(ALIGNMENT8);
+    MemoryArena view = concurrent_arena_view(&arena, ALIGNMENT8);
+    EXPECT_EQ(view.backend, MEMORY_BACKEND_CONCURRENT);
+
+    for (usize i = 0; i < 100; ++i) {
+        auto *const values = static_cast<u8 *>(memory_arena_alloc(&view, 1000));
+        values[999] = 1;
+    }
+    void *const large = memory_arena_alloc(&view, 1u << 20);
+    EXPECT_NE(large, nullptr);
+    EXPECT_GE(concurrent_arena_total_memory(&arena), view.total_memory);
+
+    // The view only detaches, its memory is released with the concurrent arena
+    memory_arena_destroy(&view);
+    concurrent_arena_destroy(&arena);
+}
+
+TEST(ConcurrentArenaTest, ExhaustedBackingYieldsNil) {
+    // The backing arena reserves its first block and fails afterwards
+    static usize reservations;
+    MemoryArenaSpecification spec = {};
+    spec.alignment = ALIGNMENT8;
+    spec.reserve = [](size_t size) -> void * { return reservations++ == 0 ? malloc(size) : nullptr; };
+    spec.release = free;
+    spec.backend = MEMORY_BACKEND_HEAP;
+    spec.block_size = 1u << 20;
+    spec.growth_factor = 1.0;
+
+    reservations = 0;
+    ConcurrentArena arena = concurrent_arena_make(&spec);
+    ASSERT_NE(arena.state, nullptr);
+    usize allocations = 0;
+    while (concurrent_arena_alloc(&arena, 1024) != nullptr && allocations < 4096) {
+        ++allocations;
+    }
+    EXPECT_GT(allocations, 0u);
+    EXPECT_LT(allocations, 4096u);
+    EXPECT_EQ(concurrent_arena_alloc(&arena, 1024), nullptr);
+    concurrent_arena_destroy(&arena);
+
+    // Without the first block, the concurrent arena cannot be created
+    reservations = 1;
+    ConcurrentArena failed = concurrent_arena_make(&spec);
+    EXPECT_EQ(failed.state, nullptr);
+}
+
+TEST(MemoryArenaTest, WideAlignment) {
+    for (MemoryAlignment const alignment : { ALIGNMENT16, ALIGNMENT32, ALIGNMENT64, ALIGNMENT_PAGE }) {
+        MemoryArena arena = memory_arena_identity(alignment);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(arena.current->base) % alignment, 0u);
+        for (usize i = 0; i < 10; ++i) {
+            void *ptr = memory_arena_alloc(&arena, 1 + i * 700);
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % alignment, 0u);
+        }
+        memory_arena_destroy(&arena);
+    }
+}
+
+TEST(MemoryArenaTest, AlignedAllocationOverride) {
+    MemoryArena arena = memory_arena_identity(ALIGNMENT8);
+    for (MemoryAlignment const alignment : { ALIGNMENT32, ALIGNMENT64, ALIGNMENT_PAGE, ALIGNMENT4 }) {
+        for (usize i = 0; i < 20; ++i) {
+            memory_arena_alloc(&arena, 3);
+            void *ptr = memory_arena_alloc_aligned(&arena, 24 + 100 * i, alignment);
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % alignment, 0u);
+        }
+    }
+
+    // Alignments below the arena alignment keep the arena alignment
+    void *ptr = memory_arena_alloc_aligned(&arena, 1, ALIGNMENT1);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % ALIGNMENT8, 0u);
+
+    memory_arena_destroy(&arena);
+
+    MemoryArena virtual_arena = memory_arena_virtual(ALIGNMENT64, 1u << 20);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(memory_arena_alloc(&virtual_arena, 5)) % ALIGNMENT64, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(memory_arena_alloc_aligned(&virtual_arena, 5, ALIGNMENT_PAGE)) % 4096, 0u);
+    memory_arena_destroy(&virtual_arena);
+}
@@ -0,0 +1,182 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Elias Engelbert Plank
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+#include <solaris/catalog.h>
+
+TEST(CatalogTest, TimelineFromSpecification) {
+    ComputeSpecification spec = {};
+    spec.date = { 2024, 1, 1, 0, 0, 0, 0 };
+    spec.steps = 10;
+    spec.step_size = 30;
+    spec.unit = UNIT_MINUTES;
+
+    ComputeTimeline timeline;
+    ASSERT_TRUE(compute_timeline_make(&timeline, &spec));
+    EXPECT_NEAR(timeline.start, 2460310.5, 1e-9);
+    EXPECT_NEAR(timeline.step, 30.0 / 1440.0, 1e-12);
+    EXPECT_EQ(timeline.steps, 10u);
+
+    spec.unit = UNIT_MONTHS;
+    EXPECT_FALSE(compute_timeline_make(&timeline, &spec));
+}
+
+TEST(CatalogTest, TimelineMatchesCalendarStepping) {
+    Catalog const catalog = catalog_acquire();
+    ComputeSpecification spec = {};
+    spec.date = { 2024, 2, 27, 18, 0, 0, 0 };
+    spec.observer = { 48.2, 16.37 };
+    spec.steps = 72;
+    spec.step_size = 1;
+    spec.unit = UNIT_HOURS;
+
+    ObserverContext const context = observer_context_make(&spec.observer);
+    MemoryArena arena = memory_arena_identity(ALIGNMENT8);
+    ComputeResult planet_result;
+    ComputeResult fixed_result;
+    compute_geographic_planet_ctx(&arena, &planet_result, &catalog.planets[3], &context, &spec);
+    compute_geographic_fixed_ctx(&arena, &fixed_result, &catalog.objects[1000], &context, &spec);
+    ASSERT_EQ(planet_result.count, spec.steps);
+    ASSERT_EQ(fixed_result.count, spec.steps);
+
+    Time it = spec.date;
+    for (usize step = 0; step < spec.steps; ++step) {
+        Equatorial const planet = planet_position_equatorial(&catalog.planets[3], &it);
+        Horizontal const planet_expected = observe_geographic_ctx(&planet, &context, &it);
+        EXPECT_NEAR(planet_result.altitudes[step], planet_expected.altitude, 1e-6);
+        EXPECT_NEAR(planet_result.azimuths[step], planet_expected.azimuth, 1e-6);
+
+        Equatorial const fixed = object_position(&catalog.objects[1000], &it);
+        Horizontal const fixed_expected = observe_geographic_ctx(&fixed, &context, &it);
+        EXPECT_NEAR(fixed_result.altitudes[step], fixed_expected.altitude, 1e-6);
+        EXPECT_NEAR(fixed_result.azimuths[step], fixed_expected.azimuth, 1e-6);
+        time_add(&it, 1, UNIT_HOURS);
+    }
+
+    memory_arena_destroy(&arena);
+}
+
+TEST(CatalogTest, SkySnapshotMatchesSingleObservations) {
+    Catalog const catalog = catalog_acquire();
+    Geographic constexpr observer = { 48.2, 16.37 };
+    Time constexpr date = { 2024, 8, 12, 23, 15, 0, 0 };
+
+    ObserverContext const context = observer_context_make(&observer);
+    MemoryArena arena = memory_arena_identity(ALIGNMENT8);
+    ComputeResult result;
+    compute_sky_snapshot_ctx(&arena, &result, &catalog, &context, time_jdn(&date));
+    ASSERT_EQ(result.count, catalog.object_count);
+
+    for (usize i = 0; i < catalog.object_count; i += 97) {
+        Equatorial const position = object_position(&catalog.objects[i], &date);
+        Horizontal const expected = observe_geographic_ctx(&position, &context, &date);
+        EXPECT_NEAR(result.altitudes[i], expected.altitude, 1e-6);
+        EXPECT_NEAR(std::remainder(result.azimuths[i] - expected.azimuth, 360.0), 0.0, 1e-6);
+    }
+
+    memory_arena_destroy(&arena);
+}
+
+TEST(CatalogTest, SkySnapshotReleasesScratch) {
+    Catalog const catalog = catalog_acquire();
+    Geographic constexpr observer = { 48.2, 16.37 };
+    ObserverContext const context = observer_context_make_offset(&observer, 0);
+    MemoryArena arena = memory_arena_identity(ALIGNMENT8);
+
+    // Only the result stays behind, the next allocation directly follows the azimuths
+    ComputeResult result;
+    compute_sky_snapshot_ctx(&arena, &result, &catalog, &context, 2460400.25);
+    MemoryArenaMark const mark = memory_arena_mark(&arena);
+    EXPECT_EQ(mark.block->base + mark.block->used, reinterpret_cast<u8 *>(result.azimuths + result.count));
+
+    memory_arena_destroy(&arena);
+}
+
+TEST(CatalogTest, ColumnsMatchObjects) {
+    Catalog catalog = catalog_acquire();
+    ASSERT_EQ(catalog.columns.count, catalog.object_count);
+    for (usize i = 0; i < catalog.object_count; i += 113) {
+        Object const &object = catalog.objects[i];
+        EXPECT_EQ(catalog.columns.right_ascensions[i], object.position.right_ascension);
+        EXPECT_EQ(catalog.columns.declinations[i], object.position.declination);
+        EXPECT_EQ(catalog.columns.magnitudes[i], object.magnitude);
+        EXPECT_EQ(catalog.columns.dimensions[i], object.dimension);
+        EXPECT_EQ(catalog.columns.classifications[i], object.classification);
+        EXPECT_EQ(catalog.columns.constellations[i], object.constellation);
+        EXPECT_EQ(catalog.columns.designations[i].index, object.designation.index);
+    }
+
+    MemoryArena arena = memory_arena_identity(ALIGNMENT8);
+    Catalog user = { catalog.planets, catalog.objects + 10, 0, 5 };
+    EXPECT_EQ(user.columns.count, 0u);
+    catalog_columns_make(&arena, &user);
+    ASSERT_EQ(user.columns.count, 5u);
+    EXPECT_EQ(user.columns.magnitudes[2], catalog.objects[12].magnitude);
+    memory_arena_destroy(&arena);
+}
+
+TEST(CatalogTest, AllPlanetsMatchSinglePlanets) {
+    Catalog const catalog = catalog_acquire();
+    Time const date = { 2024, 2, 27, 18, 0, 0, 0 };
+
+    Equatorial positions[PLANET_COUNT];
+    planet_positions_all(&date, positions);
+    EXPECT_EQ(positions[PLANET_EARTH].distance, 0.0);
+
+    for (usize i = 0; i < catalog.planet_count; ++i) {
+        Planet const *const planet = &catalog.planets[i];
+        Equatorial const expected = planet_position_equatorial(planet, &date);
+        Equatorial const &actual = positions[planet->name];
+        EXPECT_NEAR(std::remainder(actual.right_ascension - expected.right_ascension, 360.0), 0.0, 1e-9);
+        EXPECT_NEAR(actual.declination, expected.declination, 1e-9);
+        EXPECT_NEAR(actual.distance, expected.distance, 1e-12);
+    }
+}
+
+TEST(CatalogTest, AllPlanetsTimelineMatchesSinglePlanets) {
+    Catalog const catalog = catalog_acquire();
+    ComputeTimeline const timeline = { 2451545.0, 3.25, 100 };
+
+    MemoryArena arena = memory_arena_identity(ALIGNMENT8);
+    PlanetSeries series;
+    planet_positions_all_timeline(&arena, &series, &timeline);
+    ASSERT_EQ(series.steps, timeline.steps);
+
+    for (usize step = 0; step < timeline.steps; ++step) {
+        f64 const jdn = timeline.start + static_cast<f64>(step) * timeline.step;
+        Equatorial const *const positions = series.positions + step * PLANET_COUNT;
+        EXPECT_EQ(positions[PLANET_EARTH].distance, 0.0);
+        for (usize i = 0; i < catalog.planet_count; ++i) {
+            Planet const *const planet = &catalog.planets[i];
+            Equatorial const expected = planet_position_equatorial_jdn(planet, jdn);
+            Equatorial const &actual = positions[planet->name];
+            EXPECT_NEAR(std::remainder(actual.right_ascension - expected.right_ascension, 360.0), 0.0, 1e-8);
+            EXPECT_NEAR(actual.declination, expected.declination, 1e-8);
+            EXPECT_NEAR(actual.distance, expected.distance, 1e-12);
+        }
+    }
+
+    memory_arena_destroy(&arena);
+}
@@ -0,0 +1,83 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Elias Engelbert Plank
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cmath>
+
+#include <gtest/gtest.h>
+#include <solaris/catalog.h>
+#include <solaris/ephemeris.h>
+
+TEST(EphemerisTest, MatchesDirectComputation) {
+    Catalog const catalog = catalog_acquire();
+    MemoryArena arena = memory_arena_identity(ALIGNMENT8);
+    f64 constexpr start = 2460310.5;
+    f64 constexpr end = start + 400.0;
+
+    for (usize planet = 0; planet < catalog.planet_count; ++planet) {
+        Ephemeris ephemeris;
+        ephemeris_make(&arena, &ephemeris, &catalog.planets[planet], start, end, 0.0, 0);
+        for (f64 jdn = start; jdn <= end; jdn += 0.731) {
+            Equatorial const expected = planet_position_equatorial_jdn(&catalog.planets[planet], jdn);
+            Equatorial const actual = ephemeris_position(&ephemeris, jdn);
+            EXPECT_NEAR(std::remainder(actual.right_ascension - expected.right_ascension, 360.0), 0.0, 1e-7);
+            EXPECT_NEAR(actual.declination, expected.declination, 1e-7);
+            EXPECT_NEAR(actual.distance, expected.distance, 1e-9);
+        }
+
+        // Outside of the fitted range, the position is computed directly
+        Equatorial const expected = planet_position_equatorial_jdn(&catalog.planets[planet], end + 100.0);
+        Equatorial const actual = ephemeris_position(&ephemeris, end + 100.0);
+        EXPECT_NEAR(actual.right_ascension, expected.right_ascension, 1e-12);
+        EXPECT_NEAR(actual.declination, expected.declination, 1e-12);
+    }
+
+    memory_arena_destroy(&arena);
+}
+
+TEST(EphemerisTest, ComputeMatchesPlanetTimeline) {
+    Catalog const catalog = catalog_acquire();
+    Planet const *const mars = std::find_if(catalog.planets, catalog.planets + catalog.planet_count,
+                                            [](Planet const &planet) { return planet.name == PLANET_MARS; });
+    ASSERT_NE(mars, catalog.planets + catalog.planet_count);
+    Geographic constexpr observer = { 48.2, 16.37 };
+    ObserverContext const context = observer_context_make(&observer);
+    ComputeTimeline const timeline = { 2460400.25, 1.0 / 1440.0, 2880 };
+
+    MemoryArena arena = memory_arena_identity(ALIGNMENT8);
+    Ephemeris ephemeris;
+    ephemeris_make(&arena, &ephemeris, mars, timeline.start,
+                   timeline.start + timeline.step * (f64) timeline.steps, 0.0, 0);
+
+    ComputeResult expected;
+    ComputeResult actual;
+    compute_geographic_planet_timeline(&arena, &expected, mars, &context, &timeline);
+    compute_geographic_ephemeris(&arena, &actual, &ephemeris, &context, &timeline);
+    ASSERT_EQ(actual.count, expected.count);
+    for (usize i = 0; i < actual.count; ++i) {
+        EXPECT_NEAR(actual.altitudes[i], expected.altitudes[i], 1e-6);
+        EXPECT_NEAR(std::remainder(actual.azimuths[i] - expected.azimuths[i], 360.0), 0.0, 1e-6);
+    }
+
+    memory_arena_destroy(&arena);
+}
@@ -0,0 +1,251 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Elias Engelbert Plank
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cmath>
+
+#include <gtest/gtest.h>
+#include <solaris/event.h>
+
+/// Altitude of the object at the specified point in time
+static f64 object_altitude(Object const *object, ObserverContext const *context, f64 jdn) {
+    Equatorial const position = object_position_jdn(object, jdn);
+    return observe_geographic_jdn(&position, context, jdn).altitude;
+}
+
+/// Altitude of the planet at the specified point in time
+static f64 planet_altitude(Planet const *planet, ObserverContext const *context, f64 jdn) {
+    Equatorial const position = planet_position_equatorial_jdn(planet, jdn);
+    return observe_geographic_jdn(&position, context, jdn).altitude;
+}
+
+TEST(EventTest, ObjectEventsMatchDenseSampling) {
+    Catalog const catalog = catalog_acquire();
+    Geographic constexpr observer = { 48.2, 16.37 };
+    Time constexpr date = { 2024, 4, 10, 0, 0, 0, 0 };
+    ObserverContext const context = observer_context_make(&observer);
+    f64 const start = time_jdn(&date);
+
+    for (usize i = 0; i < catalog.object_count; i += 1031) {
+        Object const *const object = &catalog.objects[i];
+        RiseTransitSet const events = find_rise_transit_set_object(object, &observer, &date, 0.0);
+
+        // Scan minute samples for the crossings
+        b8 rises = false;
+        b8 sets = false;
+        f64 previous = object_altitude(object, &context, start);
+        for (usize minute = 1; minute <= 1440; ++minute) {
+            f64 const altitude = object_altitude(object, &context, start + (f64) minute / 1440.0);
+            if (!rises && previous < 0.0 && altitude >= 0.0) {
+                rises = true;
+                ASSERT_TRUE(events.rises);
+                EXPECT_NEAR(events.rise, start + (f64) minute / 1440.0, 1.0 / 1440.0);
+            }
+            if (!sets && previous >= 0.0 && altitude < 0.0) {
+                sets = true;
+                ASSERT_TRUE(events.sets);
+                EXPECT_NEAR(events.set, start + (f64) minute / 1440.0, 1.0 / 1440.0);
+            }
+            previous = altitude;
+        }
+        EXPECT_EQ(events.rises, rises);
+        EXPECT_EQ(events.sets, sets);
+        if (events.rises) {
+            EXPECT_NEAR(object_altitude(object, &context, events.rise), 0.0, 1e-3);
+        }
+        if (events.sets) {
+            EXPECT_NEAR(object_altitude(object, &context, events.set), 0.0, 1e-3);
+        }
+
+        // The transit is the highest point of the day
+        ASSERT_TRUE(events.transits);
+        EXPECT_NEAR(events.transit_altitude, object_altitude(object, &context, events.transit), 1e-3);
+        EXPECT_LT(object_altitude(object, &context, events.transit - 0.01), events.transit_altitude);
+        EXPECT_LT(object_altitude(object, &context, events.transit + 0.01), events.transit_altitude);
+    }
+}
+
+TEST(EventTest, PlanetEventsAreRootsOfTheAltitude) {
+    Catalog const catalog = catalog_acquire();
+    Geographic constexpr observer = { -33.9, 18.4 };
+    ObserverContext const context = observer_context_make(&observer);
+    f64 constexpr horizon = -0.5667;
+
+    for (usize planet = 0; planet < catalog.planet_count; ++planet) {
+        RiseTransitSet const events = find_rise_transit_set_planet_ctx(&catalog.planets[planet], &context, 2460500.5,
+                                                                       horizon);
+        EXPECT_TRUE(events.rises || events.sets) << planet_string(catalog.planets[planet].name);
+        if (events.rises) {
+            EXPECT_NEAR(planet_altitude(&catalog.planets[planet], &context, events.rise), horizon, 1e-4);
+        }
+        if (events.sets) {
+            EXPECT_NEAR(planet_altitude(&catalog.planets[planet], &context, events.set), horizon, 1e-4);
+        }
+        if (events.transits) {
+            EXPECT_NEAR(planet_altitude(&catalog.planets[planet], &context, events.transit), events.transit_altitude,
+                        1e-6);
+        }
+    }
+}
+
+TEST(EventTest, CircumpolarAndNeverRising) {
+    Geographic constexpr observer = { 48.2, 16.37 };
+    Time constexpr date = { 2024, 1, 1, 0, 0, 0, 0 };
+    Object polar = {};
+    polar.position = { 40.0, 85.0, 1.0 };
+    RiseTransitSet const circumpolar = find_rise_transit_set_object(&polar, &observer, &date, 0.0);
+    EXPECT_TRUE(circumpolar.circumpolar);
+    EXPECT_FALSE(circumpolar.rises);
+    EXPECT_FALSE(circumpolar.sets);
+    EXPECT_TRUE(circumpolar.transits);
+
+    Object southern = {};
+    southern.position = { 40.0, -70.0, 1.0 };
+    RiseTransitSet const never = find_rise_transit_set_object(&southern, &observer, &date, 0.0);
+    EXPECT_FALSE(never.circumpolar);
+    EXPECT_FALSE(never.rises);
+    EXPECT_FALSE(never.sets);
+    EXPECT_LT(never.transit_altitude, 0.0);
+}
+
+TEST(EventTest, CatalogMatchesSingleSearch) {
+    Catalog const catalog = catalog_acquire();
+    Geographic constexpr observer = { 48.2, 16.37 };
+    ObserverContext const context = observer_context_make(&observer);
+    MemoryArena arena = memory_arena_identity(ALIGNMENT8);
+
+    RiseTransitSetResult result;
+    find_rise_transit_set_catalog(&arena, &result, &catalog, &context, 2460400.5, 0.0);
+    ASSERT_EQ(result.count, catalog.object_count);
+    for (usize i = 0; i < catalog.object_count; i += 89) {
+        RiseTransitSet const expected = find_rise_transit_set_object_ctx(&catalog.objects[i], &context, 2460400.5, 0.0);
+        RiseTransitSet const &actual = result.events[i];
+        EXPECT_EQ(actual.rises, expected.rises);
+        EXPECT_EQ(actual.sets, expected.sets);
+        EXPECT_EQ(actual.transits, expected.transits);
+        EXPECT_EQ(actual.circumpolar, expected.circumpolar);
+        EXPECT_NEAR(actual.rise, expected.rise, 1e-6);
+        EXPECT_NEAR(actual.transit, expected.transit, 1e-6);
+        EXPECT_NEAR(actual.set, expected.set, 1e-6);
+    }
+
+    memory_arena_destroy(&arena);
+}
+
+/// Retrieves the planet of the catalog with the specified name
+static Planet const *planet_named(Catalog const &catalog, PlanetName name) {
+    return std::find_if(catalog.planets, catalog.planets + catalog.planet_count,
+                        [name](Planet const &planet) { return planet.name == name; });
+}
+
+/// Angular separation of two planets or a planet and the sun (nullptr) in degrees
+static f64 separation(Planet const *a, Planet const *b, f64 jdn) {
+    Equatorial const first = planet_position_equatorial_jdn(a, jdn);
+    Equatorial const second = b != nullptr ? planet_position_equatorial_jdn(b, jdn) : sun_position_equatorial_jdn(jdn);
+    f64 const ra1 = first.right_ascension * M_PI / 180.0;
+    f64 const ra2 = second.right_ascension * M_PI / 180.0;
+    f64 const dec1 = first.declination * M_PI / 180.0;
+    f64 const dec2 = second.declination * M_PI / 180.0;
+    f64 const cosine = std::sin(dec1) * std::sin(dec2) + std::cos(dec1) * std::cos(dec2) * std::cos(ra1 - ra2);
+    return std::acos(std::min(1.0, cosine)) * 180.0 / M_PI;
+}
+
+TEST(EventTest, PlanetEventsOf2020) {
+    Catalog const catalog = catalog_acquire();
+    MemoryArena arena = memory_arena_identity(ALIGNMENT8);
+    u32 constexpr outer = EVENT_BODY(PLANET_MARS) | EVENT_BODY(PLANET_JUPITER) | EVENT_BODY(PLANET_SATURN);
+    EventSpecification constexpr spec = { 2458849.5, 2459215.5, 1.0, outer };
+
+    EventResult result;
+    find_planet_events(&arena, &result, &catalog, &spec);
+    ASSERT_GT(result.count, 0u);
+
+    b8 great_conjunction = false;
+    b8 mars_opposition = false;
+    for (usize i = 0; i < result.count; ++i) {
+        Event const &event = result.events[i];
+        if (i > 0) {
+            EXPECT_LE(result.events[i - 1].jdn, event.jdn);
+        }
+        EXPECT_NE(event.kind, EVENT_ALIGNMENT);
+
+        // Jupiter and Saturn on 2020-12-21, Mars at opposition on 2020-10-13
+        u32 constexpr jupiter_saturn = EVENT_BODY(PLANET_JUPITER) | EVENT_BODY(PLANET_SATURN);
+        if (event.kind == EVENT_CONJUNCTION && event.bodies == jupiter_saturn) {
+            great_conjunction = true;
+            EXPECT_NEAR(event.jdn, 2459205.3, 1.0);
+            EXPECT_NEAR(event.separation, 0.1, 0.05);
+            Planet const *const jupiter = planet_named(catalog, PLANET_JUPITER);
+            Planet const *const saturn = planet_named(catalog, PLANET_SATURN);
+            f64 const actual = separation(jupiter, saturn, event.jdn);
+            EXPECT_NEAR(actual, event.separation, 1e-6);
+            EXPECT_GE(separation(jupiter, saturn, event.jdn - 0.1), actual);
+            EXPECT_GE(separation(jupiter, saturn, event.jdn + 0.1), actual);
+        }
+        if (event.kind == EVENT_OPPOSITION && event.bodies == (EVENT_BODY(PLANET_MARS) | EVENT_BODY_SUN)) {
+            mars_opposition = true;
+            EXPECT_NEAR(event.jdn, 2459136.5, 1.0);
+            EXPECT_NEAR(separation(planet_named(catalog, PLANET_MARS), nullptr, event.jdn), event.separation, 1e-6);
+        }
+        if (event.kind == EVENT_CONJUNCTION) {
+            EXPECT_LE(event.separation, spec.tolerance);
+        }
+    }
+    EXPECT_TRUE(great_conjunction);
+    EXPECT_TRUE(mars_opposition);
+
+    memory_arena_destroy(&arena);
+}
+
+TEST(EventTest, AlignmentIsMinimumOfTheSpread) {
+    Catalog const catalog = catalog_acquire();
+    MemoryArena arena = memory_arena_identity(ALIGNMENT8);
+    u32 constexpr bodies = EVENT_BODY(PLANET_VENUS) | EVENT_BODY(PLANET_JUPITER) | EVENT_BODY(PLANET_SATURN);
+    EventSpecification constexpr spec = { 2458849.5, 2458849.5 + 3650.0, 15.0, bodies };
+
+    EventResult result;
+    find_planet_events(&arena, &result, &catalog, &spec);
+    usize alignments = 0;
+    for (usize i = 0; i < result.count; ++i) {
+        Event const &event = result.events[i];
+        if (event.kind != EVENT_ALIGNMENT) {
+            continue;
+        }
+        alignments++;
+        EXPECT_EQ(event.bodies, bodies);
+        EXPECT_LE(event.separation, spec.tolerance);
+        auto const spread = [&](f64 jdn) {
+            Planet const *const venus = planet_named(catalog, PLANET_VENUS);
+            Planet const *const jupiter = planet_named(catalog, PLANET_JUPITER);
+            Planet const *const saturn = planet_named(catalog, PLANET_SATURN);
+            return std::max({ separation(venus, jupiter, jdn), separation(venus, saturn, jdn),
+                              separation(jupiter, saturn, jdn) });
+        };
+        EXPECT_NEAR(spread(event.jdn), event.separation, 1e-6);
+        EXPECT_GE(spread(event.jdn - 0.1), event.separation);
+        EXPECT_GE(spread(event.jdn + 0.1), event.separation);
+    }
+    EXPECT_GT(alignments, 0u);
+
+    memory_arena_destroy(&arena);
+}
@@ -144,3 +144,65 @@ TEST(LinearTest, ReferencePlaneIdentity) {
         }
     }
 }
+
+TEST(LinearTest, ObserveGeographicCtxMatchesMatrixTransform) {
+    Geographic constexpr observer = { 48.2, 16.37 };
+    Equatorial constexpr equatorial = { 83.82, -5.39, 1.0 };
+    Time constexpr date = { 2024, 3, 14, 21, 30, 15, 0 };
+
+    ObserverContext context = observer_context_make(&observer);
+    context.utc_offset = 0;
+
+    f64 const hour_angle = time_gmst(&date) + observer.longitude - equatorial.right_ascension;
+    Horizontal const expected = local_equatorial_to_horizontal(equatorial.declination, hour_angle, observer.latitude);
+    Horizontal const actual = observe_geographic_ctx(&equatorial, &context, &date);
+    NEAR_EQUAL(actual.azimuth, expected.azimuth);
+    NEAR_EQUAL(actual.altitude, expected.altitude);
+}
+
+TEST(LinearTest, ObserveGeographicCtxAppliesUtcOffset) {
+    Geographic constexpr observer = { -33.9, 18.4 };
+    Equatorial constexpr equatorial = { 201.3, -43.0, 1.0 };
+    Time constexpr utc = { 2023, 12, 31, 23, 0, 0, 0 };
+    Time constexpr local = { 2024, 1, 1, 1, 0, 0, 0 };
+
+    ObserverContext utc_context = observer_context_make(&observer);
+    utc_context.utc_offset = 0;
+    ObserverContext local_context = utc_context;
+    local_context.utc_offset = 7200;
+
+    Horizontal const expected = observe_geographic_ctx(&equatorial, &utc_context, &utc);
+    Horizontal const actual = observe_geographic_ctx(&equatorial, &local_context, &local);
+    EXPECT_NEAR(actual.azimuth, expected.azimuth, 1e-6);
+    EXPECT_NEAR(actual.altitude, expected.altitude, 1e-6);
+}
+
+TEST(LinearTest, BatchConversionMatchesScalar) {
+    constexpr usize count = 37;
+    f64 right_ascension[count], declination[count], distance[count];
+    for (usize i = 0; i < count; ++i) {
+        right_ascension[i] = -400.0 + 23.7 * (f64) i;
+        declination[i] = -90.0 + 5.0 * (f64) i;
+        distance[i] = 0.5 + 0.25 * (f64) i;
+    }
+
+    f64 x[count], y[count], z[count];
+    vector3_from_equatorial_batch(right_ascension, declination, distance, x, y, z, count);
+    for (usize i = 0; i < count; ++i) {
+        Equatorial const e = { right_ascension[i], declination[i], distance[i] };
+        Vector3 const expected = vector3_from_equatorial(&e);
+        NEAR_EQUAL(x[i], expected.x);
+        NEAR_EQUAL(y[i], expected.y);
+        NEAR_EQUAL(z[i], expected.z);
+    }
+
+    f64 back_right_ascension[count], back_declination[count], back_distance[count];
+    equatorial_from_vector3_batch(x, y, z, back_right_ascension, back_declination, back_distance, count);
+    for (usize i = 0; i < count; ++i) {
+        Vector3 const v = { x[i], y[i], z[i] };
+        Equatorial const expected = equatorial_from_vector3(&v);
+        NEAR_EQUAL(back_right_ascension[i], expected.right_ascension);
+        NEAR_EQUAL(back_declination[i], expected.declination);
+        NEAR_EQUAL(back_distance[i], expected.distance);
+    }
+}
@@ -21,6 +21,9 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <cmath>
+#include <vector>
+
 #include <gtest/gtest.h>
 #include <solaris/math.h>
 
@@ -97,4 +100,81 @@ TEST(MathTest, HMStoDegrees) {
     EXPECT_DOUBLE_EQ(math_hms_to_degrees(1, 0, 0), 15.0);
     EXPECT_DOUBLE_EQ(math_hms_to_degrees(0, 30, 0), 7.5);
     EXPECT_DOUBLE_EQ(math_hms_to_degrees(0, 0, 30), 0.125);
-}
\ No newline at end of file
+}
+
+TEST(MathTest, SinCosTiers) {
+    struct Tier {
+        MathPrecision precision;
+        f64 tolerance;
+    };
+    Tier const tiers[] = { { MATH_PRECISION_FULL, 1e-14 },
+                           { MATH_PRECISION_HIGH, 3e-12 },
+                           { MATH_PRECISION_DISPLAY, 1e-7 } };
+
+    std::vector<f64> angles;
+    for (s64 i = -7200; i <= 7200; ++i) {
+        angles.push_back(0.1 * static_cast<f64>(i) + 0.0123);
+    }
+    std::vector<f64> sines(angles.size());
+    std::vector<f64> cosines(angles.size());
+
+    MathPrecision const previous = math_precision_get();
+    for (Tier const &tier : tiers) {
+        math_precision_set(tier.precision);
+        EXPECT_EQ(math_precision_get(), tier.precision);
+
+        math_sincos_batch(angles.data(), sines.data(), cosines.data(), angles.size());
+        for (usize i = 0; i < angles.size(); ++i) {
+            f64 const radians = angles[i] * PI / 180.0;
+            f64 sine;
+            f64 cosine;
+            math_sincos(angles[i], &sine, &cosine);
+            EXPECT_NEAR(sine, std::sin(radians), tier.tolerance);
+            EXPECT_NEAR(cosine, std::cos(radians), tier.tolerance);
+            EXPECT_EQ(sines[i], sine);
+            EXPECT_EQ(cosines[i], cosine);
+            EXPECT_NEAR(math_sine(angles[i]), std::sin(radians), tier.tolerance);
+            EXPECT_NEAR(math_cosine(angles[i]), std::cos(radians), tier.tolerance);
+        }
+    }
+    math_precision_set(previous);
+
+    // Multiples of 90 degrees are reduced exactly
+    f64 sine;
+    f64 cosine;
+    math_sincos(90.0, &sine, &cosine);
+    EXPECT_EQ(sine, 1.0);
+    EXPECT_EQ(cosine, 0.0);
+}
+
+TEST(MathTest, ArcTangent2Tiers) {
+    struct Tier {
+        MathPrecision precision;
+        f64 tolerance;
+    };
+    Tier const tiers[] = { { MATH_PRECISION_FULL, 1e-12 },
+                           { MATH_PRECISION_HIGH, 1e-9 },
+                           { MATH_PRECISION_DISPLAY, 1e-6 } };
+
+    std::vector<f64> y;
+    std::vector<f64> x;
+    for (usize i = 0; i < 3600; ++i) {
+        f64 const angle = 0.1 * static_cast<f64>(i) * PI / 180.0;
+        f64 const radius = 0.5 + 0.001 * static_cast<f64>(i);
+        y.push_back(radius * std::sin(angle));
+        x.push_back(radius * std::cos(angle));
+    }
+    std::vector<f64> angles(y.size());
+
+    MathPrecision const previous = math_precision_get();
+    for (Tier const &tier : tiers) {
+        math_precision_set(tier.precision);
+        math_arc_tangent2_batch(y.data(), x.data(), angles.data(), y.size());
+        for (usize i = 0; i < y.size(); ++i) {
+            f64 const expected = std::atan2(y[i], x[i]) * 180.0 / PI;
+            EXPECT_NEAR(angles[i], expected, tier.tolerance);
+            EXPECT_NEAR(math_arc_tangent2(y[i], x[i]), expected, tier.tolerance);
+        }
+    }
+    math_precision_set(previous);
+}
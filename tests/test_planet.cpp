@@ -0,0 +1,82 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Elias Engelbert Plank
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <solaris/planet.h>
+
+namespace {
+
+/// Solves kepler's equation with newton steps in extended precision until they converge
+f64 kepler_reference(f64 const mean_anomaly, f64 const eccentricity) {
+    long double const pi = 3.141592653589793238462643383279502884L;
+    long double const turns = std::nearbyint(static_cast<long double>(mean_anomaly) / (2.0L * pi));
+    long double const M = static_cast<long double>(mean_anomaly) - turns * 2.0L * pi;
+    long double const e = eccentricity;
+    long double E = M + (std::sin(M) < 0.0L ? -0.85L : 0.85L) * e;
+    for (usize i = 0; i < 100; ++i) {
+        E -= (E - e * std::sin(E) - M) / (1.0L - e * std::cos(E));
+    }
+    return static_cast<f64>(E + turns * 2.0L * pi);
+}
+
+}// namespace
+
+TEST(PlanetTest, KeplerBatchSolvesEquation) {
+    std::vector<f64> mean_anomaly;
+    std::vector<f64> eccentricity;
+    for (usize i = 0; i <= 400; ++i) {
+        for (usize j = 0; j <= 99; ++j) {
+            mean_anomaly.push_back(-20.0 + 0.1 * static_cast<f64>(i));
+            eccentricity.push_back(0.01 * static_cast<f64>(j));
+        }
+    }
+
+    // Close to pericenter of very eccentric orbits, the equation is flat in E
+    for (f64 const M : { -1e-3, -1e-6, 1e-9, 1e-6, 1e-3, 2.0 * 3.141592653589793 + 1e-4 }) {
+        mean_anomaly.push_back(M);
+        eccentricity.push_back(0.99);
+    }
+
+    std::vector<f64> eccentric_anomaly(mean_anomaly.size());
+    kepler_solve_batch(mean_anomaly.data(), eccentricity.data(), eccentric_anomaly.data(), mean_anomaly.size());
+
+    // The error in E, not only the residual in M, stays within the documented bound
+    for (usize i = 0; i < mean_anomaly.size(); ++i) {
+        f64 const expected = kepler_reference(mean_anomaly[i], eccentricity[i]);
+        EXPECT_NEAR(eccentric_anomaly[i], expected, 1e-14)
+                << "M = " << mean_anomaly[i] << ", e = " << eccentricity[i];
+    }
+}
+
+TEST(PlanetTest, KeplerBatchCircularOrbit) {
+    f64 const mean_anomaly[] = { -3.0, -1.0, 0.0, 0.5, 2.0, 7.0 };
+    f64 const eccentricity[] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    f64 eccentric_anomaly[6];
+    kepler_solve_batch(mean_anomaly, eccentricity, eccentric_anomaly, 6);
+    for (usize i = 0; i < 6; ++i) {
+        EXPECT_NEAR(eccentric_anomaly[i], mean_anomaly[i], 1e-15);
+    }
+}
@@ -0,0 +1,173 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Elias Engelbert Plank
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <solaris/plate.h>
+
+namespace {
+
+f64 constexpr ARCSECONDS_PER_RADIAN = 206264.80624709636;
+
+/// Angular distance in arcseconds
+f64 separation(Equatorial const &a, Equatorial const &b) {
+    Equatorial ua = a, ub = b;
+    ua.distance = ub.distance = 1.0;
+    Vector3 const va = vector3_from_equatorial(&ua);
+    Vector3 const vb = vector3_from_equatorial(&ub);
+    f64 const dot = std::clamp(va.x * vb.x + va.y * vb.y + va.z * vb.z, -1.0, 1.0);
+    return math_arc_cosine(dot) * 3600.0;
+}
+
+/// Synthetic image of the catalog objects around the center, brightest first
+std::vector<PlateStar> synthetic_field(Catalog const &catalog,
+                                       Equatorial const &center,
+                                       f64 const rotation,
+                                       f64 const scale,
+                                       bool const flipped,
+                                       PlateSpecification const &spec) {
+    Vector3 const c = vector3_from_equatorial(&center);
+    f64 const east_length = std::hypot(c.x, c.y);
+    Vector3 const east = { -c.y / east_length, c.x / east_length, 0.0 };
+    Vector3 const north = { c.y * east.z - c.z * east.y, c.z * east.x - c.x * east.z, c.x * east.y - c.y * east.x };
+
+    f64 const a_re = scale / ARCSECONDS_PER_RADIAN * math_cosine(rotation);
+    f64 const a_im = scale / ARCSECONDS_PER_RADIAN * math_sine(rotation);
+    f64 const norm = a_re * a_re + a_im * a_im;
+
+    std::vector<std::pair<f64, PlateStar>> stars;
+    for (usize i = 0; i < catalog.object_count; ++i) {
+        Equatorial position = catalog.objects[i].position;
+        position.distance = 1.0;
+        Vector3 const p = vector3_from_equatorial(&position);
+        f64 const height = p.x * c.x + p.y * c.y + p.z * c.z;
+        if (height <= 0.0) {
+            continue;
+        }
+        f64 const xi = (p.x * east.x + p.y * east.y + p.z * east.z) / height;
+        f64 const eta = (p.x * north.x + p.y * north.y + p.z * north.z) / height;
+        f64 const x = (xi * a_re + eta * a_im) / norm;
+        f64 const y = (eta * a_re - xi * a_im) / norm;
+
+        PlateStar const star = { x + 0.5 * spec.width, (flipped ? -y : y) + 0.5 * spec.height };
+        if (star.x >= 0.0 && star.y >= 0.0 && star.x <= spec.width && star.y <= spec.height) {
+            stars.emplace_back(catalog.objects[i].magnitude, star);
+        }
+    }
+    std::stable_sort(stars.begin(), stars.end(), [](auto const &a, auto const &b) { return a.first < b.first; });
+
+    std::vector<PlateStar> result;
+    for (auto const &[magnitude, star] : stars) {
+        result.push_back(star);
+    }
+    return result;
+}
+
+class PlateTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite() {
+        catalog = catalog_acquire();
+        arena = memory_arena_identity(ALIGNMENT8);
+        plate_index_make(&arena, &index, &catalog, 0);
+    }
+
+    static void TearDownTestSuite() {
+        memory_arena_destroy(&arena);
+    }
+
+    static inline Catalog catalog;
+    static inline MemoryArena arena;
+    static inline PlateIndex index;
+    PlateSpecification spec = { 1200.0, 900.0, 10.0, 40.0, 0.0, 0 };
+};
+
+}// namespace
+
+TEST_F(PlateTest, IndexIsSortedByBin) {
+    ASSERT_GT(index.triangle_count, 0u);
+    EXPECT_EQ(index.offsets[0], 0u);
+    EXPECT_EQ(index.offsets[64 * 64], index.triangle_count);
+    for (usize i = 0; i < index.triangle_count; ++i) {
+        EXPECT_LE(index.ratios[2 * i], index.ratios[2 * i + 1]);
+        EXPECT_LE(index.ratios[2 * i + 1], 1.0);
+    }
+}
+
+TEST_F(PlateTest, SolvesVirgoField) {
+    Equatorial const center = { 187.0, 12.5, 1.0 };
+    std::vector<PlateStar> const stars = synthetic_field(catalog, center, 30.0, 20.0, false, spec);
+    ASSERT_GE(stars.size(), 10u);
+
+    // The scratch of the solver is released, so the arena is where it was before
+    MemoryArenaMark const before = memory_arena_mark(&arena);
+    PlateSolution const solution = plate_solve(&arena, &index, stars.data(), stars.size(), &spec);
+    MemoryArenaMark const after = memory_arena_mark(&arena);
+    EXPECT_EQ(after.block, before.block);
+    EXPECT_EQ(after.used, before.used);
+    ASSERT_TRUE(solution.solved);
+    EXPECT_FALSE(solution.flipped);
+    EXPECT_LT(separation(solution.center, center), 1.0);
+    EXPECT_NEAR(solution.rotation, 30.0, 0.01);
+    EXPECT_NEAR(solution.scale, 20.0, 0.001);
+    EXPECT_GE(solution.matches, stars.size() / 2);
+
+    Equatorial const middle = plate_solution_position(&solution, 600.0, 450.0);
+    Equatorial const corner = plate_solution_position(&solution, 0.0, 0.0);
+    EXPECT_LT(separation(middle, center), 1.0);
+    // The gnomonic projection compresses the angles towards the border
+    f64 const expected = std::atan(750.0 * 20.0 / ARCSECONDS_PER_RADIAN) * ARCSECONDS_PER_RADIAN;
+    EXPECT_NEAR(separation(corner, middle), expected, 1.0);
+}
+
+TEST_F(PlateTest, SolvesFlippedField) {
+    Equatorial const center = { 83.8, -5.4, 1.0 };
+    std::vector<PlateStar> const stars = synthetic_field(catalog, center, -75.0, 25.0, true, spec);
+    ASSERT_GE(stars.size(), 5u);
+
+    PlateSolution const solution = plate_solve(&arena, &index, stars.data(), stars.size(), &spec);
+    ASSERT_TRUE(solution.solved);
+    EXPECT_TRUE(solution.flipped);
+    EXPECT_LT(separation(solution.center, center), 1.0);
+    EXPECT_NEAR(solution.rotation, -75.0, 0.01);
+    EXPECT_NEAR(solution.scale, 25.0, 0.001);
+}
+
+TEST_F(PlateTest, RejectsRandomField) {
+    std::vector<PlateStar> stars;
+    u32 state = 12345;
+    for (usize i = 0; i < 30; ++i) {
+        state = state * 1664525u + 1013904223u;
+        f64 const x = (state >> 8) % 1200;
+        state = state * 1664525u + 1013904223u;
+        f64 const y = (state >> 8) % 900;
+        stars.push_back({ x, y });
+    }
+
+    // Every triangle of the brightest stars is tried before the plate is rejected
+    spec.stars = 6;
+    PlateSolution const solution = plate_solve(&arena, &index, stars.data(), stars.size(), &spec);
+    EXPECT_FALSE(solution.solved);
+}
@@ -0,0 +1,173 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Elias Engelbert Plank
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <solaris/spatial.h>
+
+namespace {
+
+/// Angular distance in degrees
+f64 separation(Equatorial const &a, Equatorial const &b) {
+    Equatorial ua = a, ub = b;
+    ua.distance = ub.distance = 1.0;
+    Vector3 const va = vector3_from_equatorial(&ua);
+    Vector3 const vb = vector3_from_equatorial(&ub);
+    f64 const dot = std::clamp(va.x * vb.x + va.y * vb.y + va.z * vb.z, -1.0, 1.0);
+    return math_arc_cosine(dot);
+}
+
+std::vector<usize> sorted(SpatialResult const &result) {
+    std::vector<usize> indices(result.indices, result.indices + result.count);
+    std::sort(indices.begin(), indices.end());
+    return indices;
+}
+
+}// namespace
+
+TEST(SpatialTest, ConeMatchesLinearScan) {
+    Catalog const catalog = catalog_acquire();
+    MemoryArena arena = memory_arena_identity(ALIGNMENT8);
+    SpatialIndex index;
+    spatial_index_make(&arena, &index, &catalog, 0);
+
+    Equatorial const centers[] = { { 10.68, 41.27, 1.0 }, { 83.82, -5.39, 1.0 }, { 0.0, 90.0, 1.0 }, { 359.9, -0.1, 1.0 } };
+    for (Equatorial const &center : centers) {
+        for (f64 const radius : { 0.5, 2.0, 15.0 }) {
+            SpatialResult result;
+            spatial_index_cone(&arena, &result, &index, &center, radius);
+
+            std::vector<usize> expected;
+            for (usize i = 0; i < catalog.object_count; ++i) {
+                if (separation(center, catalog.objects[i].position) <= radius) {
+                    expected.push_back(i);
+                }
+            }
+            EXPECT_EQ(sorted(result), expected);
+        }
+    }
+
+    memory_arena_destroy(&arena);
+}
+
+TEST(SpatialTest, PolygonMatchesLinearScan) {
+    Catalog const catalog = catalog_acquire();
+    MemoryArena arena = memory_arena_identity(ALIGNMENT8);
+    SpatialIndex index;
+    spatial_index_make(&arena, &index, &catalog, 4);
+
+    Equatorial const vertices[] = { { 180.0, 10.0, 1.0 }, { 195.0, 10.0, 1.0 }, { 195.0, 20.0, 1.0 }, { 180.0, 20.0, 1.0 } };
+    SpatialResult result;
+    spatial_index_polygon(&arena, &result, &index, vertices, ARRAY_SIZE(vertices));
+
+    // Reverse orientation yields the same result
+    Equatorial reversed[ARRAY_SIZE(vertices)];
+    std::reverse_copy(std::begin(vertices), std::end(vertices), reversed);
+    SpatialResult result_reversed;
+    spatial_index_polygon(&arena, &result_reversed, &index, reversed, ARRAY_SIZE(reversed));
+
+    Vector3 corners[ARRAY_SIZE(vertices)];
+    Vector3 centroid = { 0.0, 0.0, 0.0 };
+    for (usize i = 0; i < ARRAY_SIZE(vertices); ++i) {
+        corners[i] = vector3_from_equatorial(vertices + i);
+        centroid = vector3_add(&centroid, corners + i);
+    }
+    std::vector<usize> expected;
+    for (usize i = 0; i < catalog.object_count; ++i) {
+        Vector3 const p = vector3_from_equatorial(&catalog.objects[i].position);
+        bool inside = true;
+        for (usize e = 0; e < ARRAY_SIZE(vertices); ++e) {
+            Vector3 const &a = corners[e];
+            Vector3 const &b = corners[(e + 1) % ARRAY_SIZE(vertices)];
+            Vector3 const n = { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+            f64 const side = n.x * centroid.x + n.y * centroid.y + n.z * centroid.z;
+            inside = inside && (n.x * p.x + n.y * p.y + n.z * p.z) * side >= 0.0;
+        }
+        if (inside) {
+            expected.push_back(i);
+        }
+    }
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(sorted(result), expected);
+    EXPECT_EQ(sorted(result_reversed), expected);
+
+    memory_arena_destroy(&arena);
+}
+
+TEST(SpatialTest, IndexReleasesScratch) {
+    Catalog const catalog = catalog_acquire();
+    MemoryArena arena = memory_arena_identity(ALIGNMENT8);
+    SpatialIndex index;
+    spatial_index_make(&arena, &index, &catalog, 0);
+
+    // Only the index stays behind, the next allocation directly follows the sorted z coordinates
+    MemoryArenaMark const mark = memory_arena_mark(&arena);
+    EXPECT_EQ(mark.block->base + mark.block->used, reinterpret_cast<u8 *>(index.z + index.count));
+
+    // The edge normals of a polygon query are released, only the result stays behind
+    MemoryArena queries = memory_arena_identity(ALIGNMENT8);
+    MemoryArenaMark const start = memory_arena_mark(&queries);
+    Equatorial const vertices[] = { { 180.0, 10.0, 1.0 }, { 195.0, 10.0, 1.0 }, { 195.0, 20.0, 1.0 } };
+    SpatialResult result;
+    spatial_index_polygon(&queries, &result, &index, vertices, ARRAY_SIZE(vertices));
+    ASSERT_GT(result.count, 0u);
+    EXPECT_EQ(reinterpret_cast<u8 *>(result.indices), start.block->base + start.used);
+    MemoryArenaMark const end = memory_arena_mark(&queries);
+    EXPECT_EQ(end.block->base + end.used, reinterpret_cast<u8 *>(result.indices + result.count));
+
+    // Degenerate polygons yield an empty result
+    spatial_index_polygon(&queries, &result, &index, vertices, 2);
+    EXPECT_EQ(result.count, 0u);
+    Equatorial const repeated[] = { vertices[0], vertices[1], vertices[1], vertices[2] };
+    spatial_index_polygon(&queries, &result, &index, repeated, ARRAY_SIZE(repeated));
+    EXPECT_EQ(result.count, 0u);
+
+    memory_arena_destroy(&queries);
+
+    memory_arena_destroy(&arena);
+}
+
+TEST(SpatialTest, NearestMatchesLinearScan) {
+    Catalog const catalog = catalog_acquire();
+    MemoryArena arena = memory_arena_identity(ALIGNMENT8);
+    SpatialIndex index;
+    spatial_index_make(&arena, &index, &catalog, 0);
+
+    Equatorial constexpr center = { 266.4, -29.0, 1.0 };
+    SpatialResult result;
+    spatial_index_nearest(&arena, &result, &index, &center, 25);
+    ASSERT_EQ(result.count, 25u);
+
+    std::vector<std::pair<f64, usize>> expected;
+    for (usize i = 0; i < catalog.object_count; ++i) {
+        expected.emplace_back(separation(center, catalog.objects[i].position), i);
+    }
+    std::sort(expected.begin(), expected.end());
+    for (usize i = 0; i < result.count; ++i) {
+        EXPECT_NEAR(separation(center, catalog.objects[result.indices[i]].position), expected[i].first, 1e-9);
+    }
+
+    memory_arena_destroy(&arena);
+}
@@ -0,0 +1,189 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Elias Engelbert Plank
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <solaris/catalog.h>
+#include <solaris/thread.h>
+
+struct SharedResults {
+    ConcurrentArena *arena;
+    Catalog const *catalog;
+    ObserverContext const *context;
+    ComputeSpecification const *spec;
+    std::vector<ComputeResult> results;
+};
+
+static void compute_shared_range(void *data, usize begin, usize end, MemoryArena *) {
+    auto *const shared = static_cast<SharedResults *>(data);
+    MemoryArena view = concurrent_arena_view(shared->arena, ALIGNMENT8);
+    for (usize i = begin; i < end; ++i) {
+        compute_geographic_fixed_ctx(&view, &shared->results[i], shared->catalog->objects + i, shared->context,
+                                     shared->spec);
+    }
+    memory_arena_destroy(&view);
+}
+
+static void mark_range(void *data, usize begin, usize end, MemoryArena *arena) {
+    auto *const marks = static_cast<std::vector<int> *>(data);
+    auto *const scratch = static_cast<int *>(memory_arena_alloc(arena, (end - begin) * sizeof(int)));
+    for (usize i = begin; i < end; ++i) {
+        scratch[i - begin] = 1;
+    }
+    for (usize i = begin; i < end; ++i) {
+        (*marks)[i] += scratch[i - begin];
+    }
+}
+
+static void record_thread(void *data, usize begin, usize end, MemoryArena *) {
+    auto *const threads = static_cast<std::vector<std::thread::id> *>(data);
+    for (usize i = begin; i < end; ++i) {
+        (*threads)[i] = std::this_thread::get_id();
+    }
+}
+
+TEST(ThreadTest, PoolVisitsEveryIndexOnce) {
+    ThreadPool pool = thread_pool_make(4);
+    ASSERT_GE(pool.workers, 1u);
+    for (usize const count : { 0u, 3u, 1000u, 12345u }) {
+        std::vector<int> marks(count, 0);
+        thread_pool_for(&pool, count, mark_range, &marks);
+        for (usize i = 0; i < count; ++i) {
+            EXPECT_EQ(marks[i], 1) << "count " << count << " index " << i;
+        }
+    }
+    thread_pool_destroy(&pool);
+    EXPECT_EQ(pool.state, nullptr);
+}
+
+TEST(ThreadTest, PoolSplitsJobsSmallerThanThePool) {
+    ThreadPool pool = thread_pool_make(8);
+    ASSERT_GE(pool.workers, 3u);
+
+    // Every item of a job with fewer items than workers gets its own worker
+    std::vector<std::thread::id> threads(3);
+    thread_pool_for(&pool, threads.size(), record_thread, &threads);
+    std::set<std::thread::id> const distinct(threads.begin(), threads.end());
+    EXPECT_EQ(distinct.size(), threads.size());
+    thread_pool_destroy(&pool);
+}
+
+TEST(ThreadTest, ParallelComputeMatchesSerial) {
+    Catalog const catalog = catalog_acquire();
+    ComputeSpecification spec = {};
+    spec.date = { 2024, 3, 1, 0, 0, 0, 0 };
+    spec.observer = { 48.2, 16.37 };
+    spec.steps = 500;
+    spec.step_size = 3;
+    spec.unit = UNIT_HOURS;
+
+    ObserverContext const context = observer_context_make(&spec.observer);
+    ThreadPool pool = thread_pool_make(0);
+    MemoryArena arena = memory_arena_identity(ALIGNMENT8);
+
+    ComputeResult serial;
+    ComputeResult parallel;
+    compute_geographic_planet_ctx(&arena, &serial, &catalog.planets[4], &context, &spec);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(serial.altitudes) % ALIGNMENT64, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(serial.azimuths) % ALIGNMENT64, 0u);
+    compute_geographic_planet_parallel(&pool, &arena, &parallel, &catalog.planets[4], &context, &spec);
+    ASSERT_EQ(parallel.count, serial.count);
+    for (usize i = 0; i < serial.count; ++i) {
+        EXPECT_EQ(parallel.altitudes[i], serial.altitudes[i]);
+        EXPECT_EQ(parallel.azimuths[i], serial.azimuths[i]);
+    }
+
+    compute_geographic_fixed_ctx(&arena, &serial, &catalog.objects[42], &context, &spec);
+    compute_geographic_fixed_parallel(&pool, &arena, &parallel, &catalog.objects[42], &context, &spec);
+    ASSERT_EQ(parallel.count, serial.count);
+    for (usize i = 0; i < serial.count; ++i) {
+        EXPECT_EQ(parallel.altitudes[i], serial.altitudes[i]);
+        EXPECT_EQ(parallel.azimuths[i], serial.azimuths[i]);
+    }
+
+    // Months cannot be expressed as timeline, so the objects walk the calendar
+    spec.steps = 12;
+    spec.step_size = 1;
+    spec.unit = UNIT_MONTHS;
+    std::vector<ComputeResult> results(100);
+    compute_geographic_objects_parallel(&pool, &arena, results.data(), catalog.objects, results.size(), &context,
+                                        &spec);
+    for (usize object = 0; object < results.size(); object += 7) {
+        // Every series starts on its own cache line, although the steps are not a multiple of eight
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(results[object].altitudes) % ALIGNMENT64, 0u);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(results[object].azimuths) % ALIGNMENT64, 0u);
+        compute_geographic_fixed_ctx(&arena, &serial, &catalog.objects[object], &context, &spec);
+        ASSERT_EQ(results[object].count, serial.count);
+        for (usize i = 0; i < serial.count; ++i) {
+            EXPECT_EQ(results[object].altitudes[i], serial.altitudes[i]);
+            EXPECT_EQ(results[object].azimuths[i], serial.azimuths[i]);
+        }
+    }
+
+    Time constexpr date = { 2024, 8, 12, 23, 15, 0, 0 };
+    compute_sky_snapshot_ctx(&arena, &serial, &catalog, &context, time_jdn(&date));
+    compute_sky_snapshot_parallel(&pool, &arena, &parallel, &catalog, &context, time_jdn(&date));
+    ASSERT_EQ(parallel.count, serial.count);
+    for (usize i = 0; i < serial.count; ++i) {
+        EXPECT_NEAR(parallel.altitudes[i], serial.altitudes[i], 1e-9);
+        EXPECT_NEAR(parallel.azimuths[i], serial.azimuths[i], 1e-9);
+    }
+
+    memory_arena_destroy(&arena);
+    thread_pool_destroy(&pool);
+}
+
+TEST(ThreadTest, WorkersShareConcurrentArena) {
+    Catalog const catalog = catalog_acquire();
+    ComputeSpecification spec = {};
+    spec.date = { 2024, 3, 1, 0, 0, 0, 0 };
+    spec.observer = { 48.2, 16.37 };
+    spec.steps = 48;
+    spec.step_size = 30;
+    spec.unit = UNIT_MINUTES;
+
+    ObserverContext const context = observer_context_make(&spec.observer);
+    ThreadPool pool = thread_pool_make(4);
+    ConcurrentArena shared = concurrent_arena_identity(ALIGNMENT8);
+
+    SharedResults data = { &shared, &catalog, &context, &spec, std::vector<ComputeResult>(200) };
+    thread_pool_for(&pool, data.results.size(), compute_shared_range, &data);
+
+    // Results of all workers live in the shared arena until it is destroyed
+    MemoryArena arena = memory_arena_identity(ALIGNMENT8);
+    for (usize i = 0; i < data.results.size(); ++i) {
+        ComputeResult serial;
+        compute_geographic_fixed_ctx(&arena, &serial, catalog.objects + i, &context, &spec);
+        ASSERT_EQ(data.results[i].count, serial.count);
+        for (usize k = 0; k < serial.count; ++k) {
+            EXPECT_EQ(data.results[i].altitudes[k], serial.altitudes[k]);
+        }
+    }
+
+    memory_arena_destroy(&arena);
+    concurrent_arena_destroy(&shared);
+    thread_pool_destroy(&pool);
+}
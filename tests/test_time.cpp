@@ -0,0 +1,219 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Elias Engelbert Plank
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <solaris/time.h>
+
+TEST(TimeTest, InstantRoundTrip) {
+    Time const dates[] = {
+        { 2024, 2, 29, 23, 59, 59, 999 }, { 2000, 1, 1, 12, 0, 0, 0 },  { 1900, 3, 1, 0, 0, 0, 0 },
+        { 1582, 10, 15, 0, 0, 0, 0 },     { 1582, 10, 4, 18, 30, 0, 0 }, { 1000, 2, 29, 6, 0, 0, 0 },
+        { -4712, 1, 1, 12, 0, 0, 0 },     { 9999, 12, 31, 23, 59, 59, 0 },
+    };
+
+    for (Time const &date : dates) {
+        Instant const instant = instant_from_time(&date);
+        Time const converted = instant_to_time(&instant);
+        EXPECT_TRUE(time_equal(&date, &converted)) << date.year << "-" << date.month << "-" << date.day;
+        EXPECT_NEAR(instant_mjdn(&instant), time_mjdn(&date), 1e-9);
+        EXPECT_NEAR(instant_jdn(&instant), time_jdn(&date), 1e-9);
+    }
+
+    // The julian calendar is followed by the gregorian calendar without a gap
+    Time const julian = { 1582, 10, 4, 0, 0, 0, 0 };
+    Time const gregorian = { 1582, 10, 15, 0, 0, 0, 0 };
+    Instant const julian_instant = instant_from_time(&julian);
+    Instant const gregorian_instant = instant_from_time(&gregorian);
+    EXPECT_EQ(gregorian_instant.day - julian_instant.day, 1);
+    EXPECT_EQ(gregorian_instant.day, -100840);
+}
+
+TEST(TimeTest, InstantArithmetic) {
+    Time const date = { 2023, 12, 31, 23, 0, 0, 0 };
+    Instant instant = instant_from_time(&date);
+    Instant const start = instant;
+
+    instant_add(&instant, 3600 * 24 * 366 + 3600, UNIT_SECONDS);
+    Time const expected = { 2025, 1, 1, 0, 0, 0, 0 };
+    Time converted = instant_to_time(&instant);
+    EXPECT_TRUE(time_equal(&converted, &expected));
+    EXPECT_DOUBLE_EQ(instant_difference(&start, &instant), 3600.0 * 24.0 * 366.0 + 3600.0);
+    EXPECT_GT(instant_compare(&instant, &start), 0);
+    EXPECT_LT(instant_compare(&start, &instant), 0);
+
+    instant_add(&instant, -(24 * 366 + 1), UNIT_HOURS);
+    EXPECT_EQ(instant_compare(&instant, &start), 0);
+
+    instant_add_nanoseconds(&instant, -1);
+    converted = instant_to_time(&instant);
+    Time const before = { 2023, 12, 31, 22, 59, 59, 999 };
+    EXPECT_TRUE(time_equal(&converted, &before));
+
+    Instant const from_jdn = instant_from_jdn(2451545.25);
+    Time const noon = { 2000, 1, 1, 18, 0, 0, 0 };
+    converted = instant_to_time(&from_jdn);
+    EXPECT_TRUE(time_equal(&converted, &noon));
+}
+
+TEST(TimeTest, AddCarriesAcrossUnits) {
+    Time date = { 2024, 1, 31, 23, 59, 30, 0 };
+    time_add(&date, 90, UNIT_SECONDS);
+    Time expected = { 2024, 2, 1, 0, 1, 0, 0 };
+    EXPECT_TRUE(time_equal(&date, &expected));
+
+    time_add(&date, 125, UNIT_MINUTES);
+    expected = { 2024, 2, 1, 2, 6, 0, 0 };
+    EXPECT_TRUE(time_equal(&date, &expected));
+
+    time_add(&date, -125, UNIT_MINUTES);
+    time_add(&date, 366, UNIT_DAYS);
+    expected = { 2025, 2, 1, 0, 1, 0, 0 };
+    EXPECT_TRUE(time_equal(&date, &expected));
+
+    time_add(&date, -14, UNIT_MONTHS);
+    expected = { 2023, 12, 1, 0, 1, 0, 0 };
+    EXPECT_TRUE(time_equal(&date, &expected));
+}
+
+TEST(TimeTest, UnixExplicitOffset) {
+    Time const epoch = { 1970, 1, 1, 0, 0, 0, 0 };
+    EXPECT_EQ(time_unix_offset(&epoch, 0), 0);
+    EXPECT_EQ(time_unix_offset(&epoch, 3600), -3600);
+
+    Time const date = { 2024, 3, 31, 2, 30, 15, 0 };
+    s64 const timestamp = time_unix_offset(&date, 7200);
+    EXPECT_EQ(timestamp, 1711845015);
+    Time const local = time_from_unix(timestamp, 7200);
+    EXPECT_TRUE(time_equal(&local, &date));
+
+    Time const utc = time_utc_local_offset(&date, 7200);
+    Time const expected = { 2024, 3, 31, 0, 30, 15, 0 };
+    EXPECT_TRUE(time_equal(&utc, &expected));
+    EXPECT_EQ(time_difference(&utc, &date), 7200);
+
+    Time const before_epoch = time_from_unix(-1, 0);
+    Time const last_second = { 1969, 12, 31, 23, 59, 59, 0 };
+    EXPECT_TRUE(time_equal(&before_epoch, &last_second));
+}
+
+TEST(TimeTest, CachedZoneOffset) {
+    s64 const offset = time_utc_offset();
+    EXPECT_EQ(time_zone_refresh(), offset);
+    EXPECT_EQ(time_utc_offset(), offset);
+
+    Time const date = { 2024, 6, 1, 12, 0, 0, 0 };
+    EXPECT_EQ(static_cast<s64>(time_unix(&date)), time_unix_offset(&date, offset));
+
+    Time const utc = time_utc_local(&date);
+    Time const expected = time_utc_local_offset(&date, offset);
+    EXPECT_TRUE(time_equal(&utc, &expected));
+
+    // Both clocks are read separately, so they may be a second apart
+    Time const now = time_now();
+    Time const now_utc = time_utc();
+    EXPECT_NEAR(static_cast<f64>(time_difference(&now_utc, &now)), static_cast<f64>(offset), 1.0);
+}
+
+TEST(TimeTest, BatchJulianDatesAndSiderealTime) {
+    Time const date = { 2024, 2, 27, 18, 30, 0, 0 };
+    Instant instants[64];
+    f64 mjdn[64];
+    Instant it = instant_from_time(&date);
+    for (usize i = 0; i < 64; ++i) {
+        instants[i] = it;
+        mjdn[i] = instant_mjdn(&it);
+        instant_add(&it, 7, UNIT_HOURS);
+    }
+
+    f64 jdn[64];
+    f64 jc[64];
+    instant_jdn_batch(instants, jdn, jc, 64);
+    f64 gmst[64];
+    time_gmst_mjdn_batch(mjdn, gmst, 64);
+    for (usize i = 0; i < 64; ++i) {
+        EXPECT_NEAR(jdn[i], mjdn[i] + 2400000.5, 1e-9);
+        EXPECT_NEAR(jc[i], time_jc_jdn(jdn[i]), 1e-15);
+        EXPECT_NEAR(std::remainder(gmst[i] - time_gmst_mjdn(mjdn[i]), 360.0), 0.0, 1e-6);
+        EXPECT_GE(gmst[i], 0.0);
+        EXPECT_LT(gmst[i], 360.0);
+    }
+}
+
+TEST(TimeTest, SiderealTimeTimeline) {
+    f64 const start = 60000.125;
+    f64 const step = 1.0 / 1440.0;
+    usize const steps = 10000;
+
+    std::vector<f64> gmst(steps);
+    time_gmst_timeline(start, step, steps, gmst.data());
+    for (usize i = 0; i < steps; ++i) {
+        f64 const mjdn = start + static_cast<f64>(i) * step;
+        EXPECT_NEAR(std::remainder(gmst[i] - time_gmst_mjdn(mjdn), 360.0), 0.0, 1e-6);
+    }
+}
+
+TEST(TimeTest, FromJulianDayNumber) {
+    Time const dates[] = {
+        { 2000, 1, 1, 12, 0, 0, 0 },     { 2024, 2, 29, 23, 59, 59, 999 }, { 1582, 10, 4, 6, 0, 0, 0 },
+        { 1582, 10, 15, 18, 0, 0, 0 },   { 1858, 11, 17, 0, 0, 0, 0 },     { -4712, 1, 1, 12, 0, 0, 0 },
+        { 2100, 3, 1, 0, 0, 0, 1 },
+    };
+
+    for (Time const &date : dates) {
+        Time const from_jdn = time_from_jdn(time_jdn(&date));
+        Time const from_mjdn = time_from_mjdn(time_mjdn(&date));
+        EXPECT_TRUE(time_equal(&from_jdn, &date)) << date.year << "-" << date.month << "-" << date.day;
+        EXPECT_TRUE(time_equal(&from_mjdn, &date)) << date.year << "-" << date.month << "-" << date.day;
+    }
+}
+
+TEST(TimeTest, FromJulianDayNumberBatch) {
+    Time const start = { 2024, 2, 28, 22, 0, 0, 0 };
+    std::vector<f64> jdn;
+    for (usize i = 0; i < 300; ++i) {
+        jdn.push_back(time_jdn(&start) + static_cast<f64>(i) / 96.0);
+    }
+
+    std::vector<Time> dates(jdn.size());
+    time_from_jdn_batch(jdn.data(), dates.data(), jdn.size());
+    std::vector<char> strings(jdn.size() * TIME_ISO8601_SIZE);
+    time_iso8601_batch(jdn.data(), strings.data(), jdn.size());
+
+    Time it = start;
+    for (usize i = 0; i < jdn.size(); ++i) {
+        EXPECT_TRUE(time_equal(&dates[i], &it)) << i;
+        char expected[TIME_ISO8601_SIZE];
+        time_iso8601(&it, expected);
+        EXPECT_STREQ(strings.data() + i * TIME_ISO8601_SIZE, expected);
+        time_add(&it, 15, UNIT_MINUTES);
+    }
+    EXPECT_STREQ(strings.data(), "2024-02-28T22:00:00.000");
+
+    char buffer[TIME_ISO8601_SIZE];
+    Time const ancient = { -4712, 1, 1, 12, 0, 0, 0 };
+    EXPECT_EQ(time_iso8601(&ancient, buffer), 26u);
+    EXPECT_STREQ(buffer, "-004712-01-01T12:00:00.000");
+}
@@ -0,0 +1,131 @@
+//
+// MIT License
+//
+// Copyright (c) 2023 Elias Engelbert Plank
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <solaris/catalog.h>
+#include <solaris/transform.h>
+
+TEST(TransformCacheTest, ObjectPositionsMatch) {
+    Catalog const catalog = catalog_acquire();
+    TransformCache cache = transform_cache_make(TRANSFORM_CACHE_QUANTUM);
+    f64 const jdn = 2460400.25;
+
+    for (usize i = 0; i < catalog.object_count; i += 97) {
+        Equatorial const direct = object_position_jdn(catalog.objects + i, jdn);
+        Equatorial const cached = object_position_cache(catalog.objects + i, &cache, jdn);
+        EXPECT_NEAR(direct.right_ascension, cached.right_ascension, 1.0e-8);
+        EXPECT_NEAR(direct.declination, cached.declination, 1.0e-8);
+    }
+
+    // All objects share the precession of the epoch
+    EXPECT_EQ(cache.misses, 1u);
+    EXPECT_GT(cache.hits, 100u);
+}
+
+TEST(TransformCacheTest, PlanetPositionsMatch) {
+    Catalog const catalog = catalog_acquire();
+    TransformCache cache = transform_cache_make(0.0);
+
+    for (f64 jdn = 2451545.0; jdn < 2470000.0; jdn += 731.3) {
+        for (usize i = 0; i < catalog.planet_count; ++i) {
+            Vector3 const direct = planet_position_vector_jdn(catalog.planets + i, jdn);
+            Vector3 const cached = planet_position_vector_cache(catalog.planets + i, &cache, jdn);
+            EXPECT_NEAR(direct.x, cached.x, 1.0e-12);
+            EXPECT_NEAR(direct.y, cached.y, 1.0e-12);
+            EXPECT_NEAR(direct.z, cached.z, 1.0e-12);
+        }
+        Vector3 const sun = sun_position_vector_jdn(jdn);
+        Vector3 const sun_cached = sun_position_vector_cache(&cache, jdn);
+        EXPECT_NEAR(sun.x, sun_cached.x, 1.0e-12);
+        EXPECT_NEAR(sun.y, sun_cached.y, 1.0e-12);
+        EXPECT_NEAR(sun.z, sun_cached.z, 1.0e-12);
+    }
+}
+
+TEST(TransformCacheTest, EpochsAreQuantized) {
+    TransformCache cache = transform_cache_make(TRANSFORM_CACHE_QUANTUM);
+    f64 const jdn = 2460000.5;
+
+    Matrix3x3 const *const first = transform_cache_planet(&cache, jdn);
+    EXPECT_EQ(transform_cache_planet(&cache, jdn + 0.2 / 1440.0), first);
+    EXPECT_EQ(cache.misses, 1u);
+
+    // The next minute uses another slot, so both stay cached
+    Matrix3x3 const *const second = transform_cache_planet(&cache, jdn + 1.0 / 1440.0);
+    EXPECT_NE(second, first);
+    EXPECT_EQ(transform_cache_planet(&cache, jdn), first);
+    EXPECT_EQ(cache.misses, 2u);
+    EXPECT_EQ(cache.hits, 2u);
+
+    // Without a quantum only equal epochs are shared
+    TransformCache exact = transform_cache_make(0.0);
+    transform_cache_object(&exact, jdn);
+    transform_cache_object(&exact, jdn + 1.0e-9);
+    EXPECT_EQ(exact.misses, 2u);
+}
+
+TEST(TimeContextTest, PositionsMatch) {
+    Catalog const catalog = catalog_acquire();
+    f64 const jdn = 2460400.25;
+    TimeContext const time = time_context_make(jdn, 3600);
+
+    EXPECT_DOUBLE_EQ(time.jc, time_jc_jdn(jdn));
+    EXPECT_DOUBLE_EQ(time.obliquity, ecliptic_drift(time.jc));
+
+    for (usize i = 0; i < catalog.planet_count; ++i) {
+        Vector3 const direct = planet_position_vector_jdn(catalog.planets + i, jdn);
+        Vector3 const context = planet_position_vector_context(catalog.planets + i, &time);
+        EXPECT_NEAR(direct.x, context.x, 1.0e-12);
+        EXPECT_NEAR(direct.y, context.y, 1.0e-12);
+        EXPECT_NEAR(direct.z, context.z, 1.0e-12);
+    }
+    Equatorial const sun = sun_position_equatorial_jdn(jdn);
+    Equatorial const sun_context = sun_position_equatorial_context(&time);
+    EXPECT_NEAR(sun.right_ascension, sun_context.right_ascension, 1.0e-8);
+    EXPECT_NEAR(sun.declination, sun_context.declination, 1.0e-8);
+
+    for (usize i = 0; i < catalog.object_count; i += 97) {
+        Equatorial const direct = object_position_jdn(catalog.objects + i, jdn);
+        Equatorial const context = object_position_context(catalog.objects + i, &time);
+        EXPECT_NEAR(direct.right_ascension, context.right_ascension, 1.0e-8);
+        EXPECT_NEAR(direct.declination, context.declination, 1.0e-8);
+    }
+}
+
+TEST(TimeContextTest, ObservationsMatch) {
+    Catalog const catalog = catalog_acquire();
+    Geographic const observer = { 48.2, 16.37 };
+    ObserverContext const observer_context = observer_context_make_offset(&observer, 7200);
+
+    Time const date = { 2024, 6, 21, 23, 30, 0, 0 };
+    TimeContext const time = time_context_observer(&date, &observer_context);
+    EXPECT_NEAR(time.gmst + observer.longitude, observer_context_lmst(&observer_context, time_jdn(&date)), 1.0e-9);
+
+    for (usize i = 0; i < catalog.object_count; i += 131) {
+        Equatorial const position = object_position_context(catalog.objects + i, &time);
+        Horizontal const direct = observe_geographic_jdn(&position, &observer_context, time.jdn);
+        Horizontal const context = observe_geographic_context(&position, &observer_context, &time);
+        EXPECT_NEAR(direct.altitude, context.altitude, 1.0e-9);
+        EXPECT_NEAR(direct.azimuth, context.azimuth, 1.0e-9);
+    }
+}